@@ -0,0 +1,309 @@
+#ifndef S21_FIXED_MATRIX_H_
+#define S21_FIXED_MATRIX_H_
+
+// Матрица с размерами, известными на этапе компиляции. Элементы хранятся
+// в самом объекте (без кучи), циклы имеют постоянные границы и полностью
+// разворачиваются компилятором, а несовпадение размеров в MulMatrix,
+// SumMatrix и т.п. - ошибка компиляции, а не проверка во время выполнения.
+// Большинство операций constexpr. Тип элементов и допуск EqMatrix - как у
+// S21BasicMatrix<T>.
+
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+template <typename T, int Rows, int Cols>
+class S21BasicFixedMatrix {
+  static_assert(Rows > 0 && Cols > 0, "Matrix size cannot be less than 1x1");
+
+ public:
+  using value_type = T;
+
+  // Конструкторы:
+  constexpr S21BasicFixedMatrix() = default;
+  // Элементы построчно; недостающие заполняются нулями.
+  constexpr S21BasicFixedMatrix(std::initializer_list<T> values) {
+    if (static_cast<int>(values.size()) > Rows * Cols) {
+      throw std::invalid_argument("Too many values for the matrix size");
+    }
+    int k = 0;
+    for (T value : values) data_[k++] = value;
+  }
+  explicit S21BasicFixedMatrix(const S21BasicMatrix<T>& other) {
+    if (other.GetRows() != Rows || other.GetCols() != Cols) {
+      throw std::invalid_argument("Matrix sizes do not match");
+    }
+    for (int i = 0; i < Rows; ++i) {
+      for (int j = 0; j < Cols; ++j) data_[i * Cols + j] = other(i, j);
+    }
+  }
+
+  // Операции над матрицами:
+  constexpr bool EqMatrix(const S21BasicFixedMatrix& other) const noexcept {
+    bool res = true;
+    for (int k = 0; k < Rows * Cols; ++k) {
+      T diff = data_[k] - other.data_[k];
+      if (Abs(diff) >= S21MatrixTolerance<T>::kEqual) res = false;
+    }
+    return res;
+  }
+  constexpr void SumMatrix(const S21BasicFixedMatrix& other) noexcept {
+    for (int k = 0; k < Rows * Cols; ++k) data_[k] += other.data_[k];
+  }
+  constexpr void SubMatrix(const S21BasicFixedMatrix& other) noexcept {
+    for (int k = 0; k < Rows * Cols; ++k) data_[k] -= other.data_[k];
+  }
+  constexpr void MulNumber(T num) noexcept {
+    for (int k = 0; k < Rows * Cols; ++k) data_[k] *= num;
+  }
+  // На месте умножать можно только на квадратную матрицу Cols x Cols:
+  // размер *this при этом не меняется.
+  constexpr void MulMatrix(
+      const S21BasicFixedMatrix<T, Cols, Cols>& other) noexcept {
+    *this = *this * other;
+  }
+  constexpr S21BasicFixedMatrix<T, Cols, Rows> Transpose() const noexcept {
+    S21BasicFixedMatrix<T, Cols, Rows> result;
+    for (int i = 0; i < Rows; ++i) {
+      for (int j = 0; j < Cols; ++j) result.At(j, i) = At(i, j);
+    }
+    return result;
+  }
+  constexpr S21BasicFixedMatrix CalcComplements() const noexcept {
+    static_assert(Rows == Cols, "Matrix must be square");
+    S21BasicFixedMatrix result;
+    if constexpr (Rows == 1) {
+      result.data_[0] = T(1);
+    } else {
+      for (int i = 0; i < Rows; ++i) {
+        for (int j = 0; j < Cols; ++j) {
+          T minor = Minor(i, j).Determinant();
+          result.At(i, j) = (i + j) % 2 == 0 ? minor : -minor;
+        }
+      }
+    }
+    return result;
+  }
+  constexpr T Determinant() const noexcept {
+    static_assert(Rows == Cols, "Matrix must be square");
+    T result = T(0);
+    if constexpr (Rows == 1) {
+      result = data_[0];
+    } else if constexpr (Rows == 2) {
+      result = data_[0] * data_[3] - data_[1] * data_[2];
+    } else if constexpr (Rows <= 4) {
+      // Разложение по первой строке разворачивается полностью.
+      for (int j = 0; j < Cols; ++j) {
+        T term = data_[j] * Minor(0, j).Determinant();
+        result += j % 2 == 0 ? term : -term;
+      }
+    } else {
+      result = EliminationDeterminant();
+    }
+    return result;
+  }
+  // Гаусс-Жордан с выбором ведущего элемента по столбцу. Матрица
+  // вырождена, если модуль ведущего элемента не больше n * eps * max|a_ij|,
+  // как у S21Matrix (s21_kernels::SingularTolerance), так что оба класса
+  // одинаково решают, какие матрицы обратимы.
+  constexpr S21BasicFixedMatrix InverseMatrix() const {
+    static_assert(Rows == Cols, "Matrix must be square");
+    const T tolerance =
+        Rows * std::numeric_limits<T>::epsilon() * MaxAbs();
+    S21BasicFixedMatrix a(*this);
+    S21BasicFixedMatrix result;
+    for (int i = 0; i < Rows; ++i) result.At(i, i) = T(1);
+    for (int k = 0; k < Rows; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < Rows; ++i) {
+        if (Abs(a.At(i, k)) > Abs(a.At(pivot, k))) pivot = i;
+      }
+      if (Abs(a.At(pivot, k)) <= tolerance) {
+        throw std::invalid_argument("Matrix determinant must be > 0.");
+      }
+      a.SwapRows(k, pivot);
+      result.SwapRows(k, pivot);
+      const T inverse = T(1) / a.At(k, k);
+      for (int j = 0; j < Cols; ++j) {
+        a.At(k, j) *= inverse;
+        result.At(k, j) *= inverse;
+      }
+      for (int i = 0; i < Rows; ++i) {
+        if (i == k) continue;
+        const T factor = a.At(i, k);
+        for (int j = 0; j < Cols; ++j) {
+          a.At(i, j) -= factor * a.At(k, j);
+          result.At(i, j) -= factor * result.At(k, j);
+        }
+      }
+    }
+    return result;
+  }
+
+  // Операторы:
+  constexpr bool operator==(const S21BasicFixedMatrix& other) const noexcept {
+    return EqMatrix(other);
+  }
+  constexpr S21BasicFixedMatrix operator+(
+      const S21BasicFixedMatrix& other) const {
+    S21BasicFixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+  constexpr S21BasicFixedMatrix operator-(
+      const S21BasicFixedMatrix& other) const {
+    S21BasicFixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+  constexpr S21BasicFixedMatrix operator*(T num) const noexcept {
+    S21BasicFixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+  template <int K>
+  constexpr S21BasicFixedMatrix<T, Rows, K> operator*(
+      const S21BasicFixedMatrix<T, Cols, K>& other) const noexcept {
+    S21BasicFixedMatrix<T, Rows, K> result;
+    for (int i = 0; i < Rows; ++i) {
+      for (int k = 0; k < Cols; ++k) {
+        for (int j = 0; j < K; ++j) {
+          result.At(i, j) += At(i, k) * other.At(k, j);
+        }
+      }
+    }
+    return result;
+  }
+  constexpr S21BasicFixedMatrix& operator+=(
+      const S21BasicFixedMatrix& other) noexcept {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21BasicFixedMatrix& operator-=(
+      const S21BasicFixedMatrix& other) noexcept {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21BasicFixedMatrix& operator*=(T num) noexcept {
+    MulNumber(num);
+    return *this;
+  }
+  constexpr S21BasicFixedMatrix& operator*=(
+      const S21BasicFixedMatrix<T, Cols, Cols>& other) noexcept {
+    MulMatrix(other);
+    return *this;
+  }
+  constexpr T& operator()(int i, int j) {
+    if (i < 0 || j < 0 || i >= Rows || j >= Cols) {
+      throw std::out_of_range("Index is out of the matrix range");
+    }
+    return At(i, j);
+  }
+  constexpr T operator()(int i, int j) const {
+    if (i < 0 || j < 0 || i >= Rows || j >= Cols) {
+      throw std::out_of_range("Index is out of the matrix range");
+    }
+    return At(i, j);
+  }
+  explicit operator S21BasicMatrix<T>() const {
+    S21BasicMatrix<T> result(Rows, Cols);
+    for (int i = 0; i < Rows; ++i) {
+      for (int j = 0; j < Cols; ++j) result(i, j) = At(i, j);
+    }
+    return result;
+  }
+
+  // Доп. функции:
+  static constexpr int GetRows() noexcept { return Rows; }
+  static constexpr int GetCols() noexcept { return Cols; }
+
+ private:
+  template <typename U, int R, int C>
+  friend class S21BasicFixedMatrix;
+
+  constexpr T& At(int i, int j) noexcept { return data_[i * Cols + j]; }
+  constexpr T At(int i, int j) const noexcept { return data_[i * Cols + j]; }
+
+  constexpr S21BasicFixedMatrix<T, Rows - 1, Cols - 1> Minor(
+      int row, int col) const noexcept {
+    S21BasicFixedMatrix<T, Rows - 1, Cols - 1> result;
+    for (int i = 0, min_i = 0; i < Rows; ++i) {
+      if (i == row) continue;
+      for (int j = 0, min_j = 0; j < Cols; ++j) {
+        if (j == col) continue;
+        result.At(min_i, min_j++) = At(i, j);
+      }
+      ++min_i;
+    }
+    return result;
+  }
+
+  static constexpr T Abs(T value) noexcept {
+    return value < 0 ? -value : value;
+  }
+
+  constexpr T MaxAbs() const noexcept {
+    T max = T(0);
+    for (int k = 0; k < Rows * Cols; ++k) {
+      if (Abs(data_[k]) > max) max = Abs(data_[k]);
+    }
+    return max;
+  }
+
+  constexpr void SwapRows(int a, int b) noexcept {
+    for (int j = 0; a != b && j < Cols; ++j) {
+      T tmp = At(a, j);
+      At(a, j) = At(b, j);
+      At(b, j) = tmp;
+    }
+  }
+
+  // Метод Гаусса с выбором ведущего элемента для размеров больше 4x4.
+  constexpr T EliminationDeterminant() const noexcept {
+    S21BasicFixedMatrix lu(*this);
+    T result = T(1);
+    for (int k = 0; k < Rows && result != T(0); ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < Rows; ++i) {
+        if (Abs(lu.At(i, k)) > Abs(lu.At(pivot, k))) pivot = i;
+      }
+      if (lu.At(pivot, k) == T(0)) {
+        result = T(0);
+      } else {
+        if (pivot != k) {
+          lu.SwapRows(k, pivot);
+          result = -result;
+        }
+        result *= lu.At(k, k);
+        for (int i = k + 1; i < Rows; ++i) {
+          T factor = lu.At(i, k) / lu.At(k, k);
+          for (int j = k + 1; j < Cols; ++j) {
+            lu.At(i, j) -= factor * lu.At(k, j);
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  T data_[Rows * Cols] = {};
+};
+
+// Тип числа выводится из матрицы, поэтому 2 * matrix компилируется.
+template <typename T, int Rows, int Cols>
+constexpr S21BasicFixedMatrix<T, Rows, Cols> operator*(
+    typename S21BasicFixedMatrix<T, Rows, Cols>::value_type num,
+    const S21BasicFixedMatrix<T, Rows, Cols>& other) noexcept {
+  return other * num;
+}
+
+template <int Rows, int Cols>
+using S21FixedMatrix = S21BasicFixedMatrix<double, Rows, Cols>;
+template <int Rows, int Cols>
+using S21FixedMatrixF = S21BasicFixedMatrix<float, Rows, Cols>;
+template <int Rows, int Cols>
+using S21FixedMatrixLD = S21BasicFixedMatrix<long double, Rows, Cols>;
+
+#endif  // S21_FIXED_MATRIX_H_
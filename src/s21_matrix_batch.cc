@@ -0,0 +1,353 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Во всех функциях блока p[e * kLanes + l] - элемент e матрицы l, циклы по
+// l самые внутренние и векторизуются.
+
+// c = a * b для блока матриц m x k и k x n.
+template <typename T, int kLanes>
+void MulBlock(const T *a, const T *b, T *c, int m, int k, int n) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      T acc[kLanes] = {};
+      for (int p = 0; p < k; ++p) {
+        const T *x = a + static_cast<std::ptrdiff_t>(i * k + p) * kLanes;
+        const T *y = b + static_cast<std::ptrdiff_t>(p * n + j) * kLanes;
+        for (int l = 0; l < kLanes; ++l) acc[l] += x[l] * y[l];
+      }
+      T *z = c + static_cast<std::ptrdiff_t>(i * n + j) * kLanes;
+      for (int l = 0; l < kLanes; ++l) z[l] = acc[l];
+    }
+  }
+}
+
+template <typename T, int kLanes>
+void TransposeBlock(const T *a, T *out, int m, int n) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const T *x = a + static_cast<std::ptrdiff_t>(i * n + j) * kLanes;
+      T *y = out + static_cast<std::ptrdiff_t>(j * m + i) * kLanes;
+      for (int l = 0; l < kLanes; ++l) y[l] = x[l];
+    }
+  }
+}
+
+// Ставит в строку k каждой матрицы строку с наибольшим по модулю
+// элементом столбца k среди строк k..n-1 и меняет знак sign[l], если
+// строки переставлены. Строки длиной width, переставляются столбцы
+// k..width-1: левее в строках k..n-1 уже нули.
+template <typename T, int kLanes>
+void PivotBlock(T *w, int n, int width, int k, T *sign) {
+  auto at = [&](int i, int j, int l) -> T & {
+    return w[static_cast<std::ptrdiff_t>(i * width + j) * kLanes + l];
+  };
+  for (int l = 0; l < kLanes; ++l) {
+    int pivot = k;
+    T max = std::fabs(at(k, k, l));
+    for (int i = k + 1; i < n; ++i) {
+      if (std::fabs(at(i, k, l)) > max) {
+        max = std::fabs(at(i, k, l));
+        pivot = i;
+      }
+    }
+    if (pivot == k) continue;
+    sign[l] = -sign[l];
+    for (int j = k; j < width; ++j) std::swap(at(k, j, l), at(pivot, j, l));
+  }
+}
+
+// Определители блока матриц n x n. Для n <= 3 - явные формулы, иначе
+// исключение Гаусса в w (n * n * kLanes элементов).
+template <typename T, int kLanes>
+void DeterminantBlock(const T *a, int n, T *w, T *det) {
+  auto at = [&](int i, int j) {
+    return a + static_cast<std::ptrdiff_t>(i * n + j) * kLanes;
+  };
+  if (n == 1) {
+    for (int l = 0; l < kLanes; ++l) det[l] = a[l];
+  } else if (n == 2) {
+    const T *a00 = at(0, 0), *a01 = at(0, 1), *a10 = at(1, 0), *a11 = at(1, 1);
+    for (int l = 0; l < kLanes; ++l) {
+      det[l] = a00[l] * a11[l] - a01[l] * a10[l];
+    }
+  } else if (n == 3) {
+    const T *a00 = at(0, 0), *a01 = at(0, 1), *a02 = at(0, 2);
+    const T *a10 = at(1, 0), *a11 = at(1, 1), *a12 = at(1, 2);
+    const T *a20 = at(2, 0), *a21 = at(2, 1), *a22 = at(2, 2);
+    for (int l = 0; l < kLanes; ++l) {
+      det[l] = a00[l] * (a11[l] * a22[l] - a12[l] * a21[l]) -
+               a01[l] * (a10[l] * a22[l] - a12[l] * a20[l]) +
+               a02[l] * (a10[l] * a21[l] - a11[l] * a20[l]);
+    }
+  } else {
+    std::copy(a, a + static_cast<std::ptrdiff_t>(n) * n * kLanes, w);
+    for (int l = 0; l < kLanes; ++l) det[l] = T(1);
+    for (int k = 0; k < n; ++k) {
+      PivotBlock<T, kLanes>(w, n, n, k, det);
+      const T *row_k = w + static_cast<std::ptrdiff_t>(k * n) * kLanes;
+      const T *pivot = row_k + static_cast<std::ptrdiff_t>(k) * kLanes;
+      for (int l = 0; l < kLanes; ++l) det[l] *= pivot[l];
+      for (int i = k + 1; i < n; ++i) {
+        T *row_i = w + static_cast<std::ptrdiff_t>(i * n) * kLanes;
+        T factor[kLanes];
+        // Нулевой ведущий элемент: определитель уже 0, а исключение
+        // пропускается без деления на ноль.
+        for (int l = 0; l < kLanes; ++l) {
+          factor[l] = pivot[l] != T(0) ? row_i[k * kLanes + l] / pivot[l]
+                                       : T(0);
+        }
+        for (int j = k + 1; j < n; ++j) {
+          for (int l = 0; l < kLanes; ++l) {
+            row_i[j * kLanes + l] -= factor[l] * row_k[j * kLanes + l];
+          }
+        }
+      }
+    }
+  }
+}
+
+// Гаусс-Жордан над [A | E] в w (n * 2n * kLanes элементов), обратные
+// матрицы записываются в out. Возвращает false, если одна из первых lanes
+// матриц вырождена; остальные (хвост блока) не проверяются.
+template <typename T, int kLanes>
+bool InverseBlock(const T *a, int n, int lanes, T *w, T *out) {
+  const int width = 2 * n;
+  T tolerance[kLanes] = {};
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < width; ++j) {
+      T *y = w + static_cast<std::ptrdiff_t>(i * width + j) * kLanes;
+      if (j < n) {
+        const T *x = a + static_cast<std::ptrdiff_t>(i * n + j) * kLanes;
+        for (int l = 0; l < kLanes; ++l) {
+          y[l] = x[l];
+          tolerance[l] = std::max(tolerance[l], std::fabs(x[l]));
+        }
+      } else {
+        for (int l = 0; l < kLanes; ++l) y[l] = T(j - n == i);
+      }
+    }
+  }
+  // Порог как у s21_kernels::SingularTolerance().
+  for (int l = 0; l < kLanes; ++l) {
+    tolerance[l] *= n * std::numeric_limits<T>::epsilon();
+  }
+  // Знак перестановки для обращения не нужен.
+  T sign[kLanes] = {};
+  bool regular = true;
+  for (int k = 0; k < n; ++k) {
+    PivotBlock<T, kLanes>(w, n, width, k, sign);
+    T *row_k = w + static_cast<std::ptrdiff_t>(k * width) * kLanes;
+    T inverse[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      const T pivot = row_k[k * kLanes + l];
+      const bool singular = std::fabs(pivot) <= tolerance[l];
+      if (singular && l < lanes) regular = false;
+      inverse[l] = singular ? T(1) : T(1) / pivot;
+    }
+    for (int j = k; j < width; ++j) {
+      for (int l = 0; l < kLanes; ++l) row_k[j * kLanes + l] *= inverse[l];
+    }
+    for (int i = 0; i < n; ++i) {
+      if (i == k) continue;
+      T *row_i = w + static_cast<std::ptrdiff_t>(i * width) * kLanes;
+      T factor[kLanes];
+      for (int l = 0; l < kLanes; ++l) factor[l] = row_i[k * kLanes + l];
+      for (int j = k; j < width; ++j) {
+        for (int l = 0; l < kLanes; ++l) {
+          row_i[j * kLanes + l] -= factor[l] * row_k[j * kLanes + l];
+        }
+      }
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    const T *x = w + static_cast<std::ptrdiff_t>(i * width + n) * kLanes;
+    std::copy(x, x + static_cast<std::ptrdiff_t>(n) * kLanes,
+              out + static_cast<std::ptrdiff_t>(i * n) * kLanes);
+  }
+  return regular;
+}
+
+// Вызывает blocks(begin, end) для диапазонов блоков: одним вызовом, если
+// работы work меньше parallel_size, иначе по несколько диапазонов на поток.
+template <typename F>
+void ForEachBlock(int count, std::ptrdiff_t work, std::ptrdiff_t parallel_size,
+                  const F &blocks) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  if (work < parallel_size || pool.GetThreadCount() == 1 || count < 2) {
+    blocks(0, count);
+    return;
+  }
+  const int tasks = std::min(count, 4 * pool.GetThreadCount());
+  pool.ParallelFor(tasks, [&](int t) {
+    blocks(static_cast<int>(static_cast<std::ptrdiff_t>(count) * t / tasks),
+           static_cast<int>(static_cast<std::ptrdiff_t>(count) * (t + 1) /
+                            tasks));
+  });
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols,
+                                            std::pmr::memory_resource *resource)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      data_(resource != nullptr ? resource : std::pmr::get_default_resource()) {
+  if (count < 0) {
+    throw std::invalid_argument("Invalid batch size " + std::to_string(count));
+  }
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Matrix size cannot be less than 1x1");
+  }
+  data_.assign(Blocks() * BlockSize(), T(0));
+  // Хвост последнего блока - единичные матрицы, чтобы пакетные операции
+  // не делили на ноль в матрицах, которых нет.
+  if (rows_ == cols_ && count_ % kLanes != 0) {
+    T *tail = Block(Blocks() - 1);
+    for (int i = 0; i < rows_; ++i) {
+      T *x = tail + static_cast<std::ptrdiff_t>(i * cols_ + i) * kLanes;
+      std::fill(x + count_ % kLanes, x + kLanes, T(1));
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch &other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_, other.GetResource()) {}
+
+// Пакетные операции:
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::BatchMulMatrix(
+    const S21BasicMatrixBatch &other) const {
+  if (count_ != other.count_ || cols_ != other.rows_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  S21BasicMatrixBatch result(count_, rows_, other.cols_, GetResource());
+  const std::ptrdiff_t work =
+      static_cast<std::ptrdiff_t>(count_) * rows_ * cols_ * other.cols_;
+  ForEachBlock(Blocks(), work, kParallelSize, [&](int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+      MulBlock<T, kLanes>(Block(b), other.Block(b), result.Block(b), rows_,
+                          cols_, other.cols_);
+    }
+  });
+  return result;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::BatchDeterminant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+  std::vector<T> result(Blocks() * kLanes);
+  const std::ptrdiff_t work =
+      static_cast<std::ptrdiff_t>(count_) * rows_ * rows_ * rows_;
+  ForEachBlock(Blocks(), work, kParallelSize, [&](int begin, int end) {
+    std::vector<T> w(rows_ > 3 ? BlockSize() : 0);
+    for (int b = begin; b < end; ++b) {
+      DeterminantBlock<T, kLanes>(Block(b), rows_, w.data(),
+                                  result.data() + b * kLanes);
+    }
+  });
+  result.resize(count_);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::BatchInverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+  S21BasicMatrixBatch result(count_, rows_, cols_, GetResource());
+  const std::ptrdiff_t work =
+      static_cast<std::ptrdiff_t>(count_) * 2 * rows_ * rows_ * rows_;
+  ForEachBlock(Blocks(), work, kParallelSize, [&](int begin, int end) {
+    std::vector<T> w(2 * BlockSize());
+    for (int b = begin; b < end; ++b) {
+      const int lanes = std::min(kLanes, count_ - b * kLanes);
+      if (!InverseBlock<T, kLanes>(Block(b), rows_, lanes, w.data(),
+                                   result.Block(b))) {
+        throw std::invalid_argument("Matrix determinant must be > 0.");
+      }
+    }
+  });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::BatchTranspose() const {
+  S21BasicMatrixBatch result(count_, cols_, rows_, GetResource());
+  const std::ptrdiff_t work = static_cast<std::ptrdiff_t>(count_) * rows_ *
+                              cols_;
+  ForEachBlock(Blocks(), work, kParallelSize, [&](int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+      TransposeBlock<T, kLanes>(Block(b), result.Block(b), rows_, cols_);
+    }
+  });
+  return result;
+}
+
+// Доступ к матрицам:
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int k, const S21BasicMatrixView<T> &matrix) {
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  T *x = data_.data() + Offset(k, 0, 0);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      x[static_cast<std::ptrdiff_t>(i * cols_ + j) * kLanes] = matrix.At(i, j);
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int k) const {
+  const T *x = data_.data() + Offset(k, 0, 0);
+  S21BasicMatrix<T> result(rows_, cols_, kS21Uninitialized, GetResource());
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      result(i, j) = x[static_cast<std::ptrdiff_t>(i * cols_ + j) * kLanes];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+T &S21BasicMatrixBatch<T>::operator()(int k, int i, int j) {
+  return data_[Offset(k, i, j)];
+}
+
+template <typename T>
+T S21BasicMatrixBatch<T>::operator()(int k, int i, int j) const {
+  return data_[Offset(k, i, j)];
+}
+
+template <typename T>
+std::ptrdiff_t S21BasicMatrixBatch<T>::Offset(int k, int i, int j) const {
+  if (k < 0 || k >= count_ || i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return (k / kLanes) * BlockSize() +
+         static_cast<std::ptrdiff_t>(i * cols_ + j) * kLanes + k % kLanes;
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
@@ -0,0 +1,95 @@
+#ifndef S21_MATRIX_BATCH_H_
+#define S21_MATRIX_BATCH_H_
+
+// Пакет из count матриц одного размера в одном буфере. Для миллионов
+// независимых 3x3 и 4x4 отдельные S21BasicMatrix платят за выделение и
+// вызов на каждую матрицу; пакетные операции проходят весь пакет одним
+// вызовом.
+//
+// Буфер чередующийся (AoSoA): матрицы идут блоками по kLanes, и в блоке
+// один и тот же элемент (i, j) всех kLanes матриц лежит подряд. Каждая
+// операция над элементом поэтому выполняется сразу для kLanes матриц
+// векторными инструкциями, а блоки независимы и делятся между потоками
+// S21ThreadPool.
+//
+// Шаблон определён в s21_matrix_batch.cc и инстанцирован для float, double
+// и long double.
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  using value_type = T;
+
+  // Матриц в блоке чередования.
+  static constexpr int kLanes = 16;
+  // Начиная с этого числа операций пакет обрабатывается параллельно.
+  static constexpr std::ptrdiff_t kParallelSize = 1 << 16;
+
+  // count нулевых матриц rows x cols.
+  S21BasicMatrixBatch(int count, int rows, int cols,
+                      std::pmr::memory_resource* resource = nullptr);
+  S21BasicMatrixBatch(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch(S21BasicMatrixBatch&& other) noexcept = default;
+  S21BasicMatrixBatch& operator=(const S21BasicMatrixBatch& other) = default;
+  S21BasicMatrixBatch& operator=(S21BasicMatrixBatch&& other) = default;
+
+  // Пакетные операции, k-я матрица результата получена из k-х матриц
+  // операндов:
+  S21BasicMatrixBatch BatchMulMatrix(const S21BasicMatrixBatch& other) const;
+  std::vector<T> BatchDeterminant() const;
+  // Гаусс-Жордан с выбором ведущего элемента отдельно в каждой матрице.
+  // Если хоть одна матрица вырождена, бросает то же исключение, что и
+  // S21BasicMatrix::InverseMatrix().
+  S21BasicMatrixBatch BatchInverseMatrix() const;
+  S21BasicMatrixBatch BatchTranspose() const;
+
+  // Копирование отдельных матриц.
+  void Set(int k, const S21BasicMatrixView<T>& matrix);
+  S21BasicMatrix<T> Get(int k) const;
+  // Элемент (i, j) k-й матрицы.
+  T& operator()(int k, int i, int j);
+  T operator()(int k, int i, int j) const;
+
+  // Доп. функции:
+  int GetCount() const noexcept { return count_; }
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return data_.get_allocator().resource();
+  }
+
+ private:
+  int Blocks() const noexcept { return (count_ + kLanes - 1) / kLanes; }
+  std::ptrdiff_t BlockSize() const noexcept {
+    return static_cast<std::ptrdiff_t>(rows_) * cols_ * kLanes;
+  }
+  T* Block(int b) noexcept { return data_.data() + b * BlockSize(); }
+  const T* Block(int b) const noexcept {
+    return data_.data() + b * BlockSize();
+  }
+  std::ptrdiff_t Offset(int k, int i, int j) const;
+
+  int count_ = {0};
+  int rows_ = {0};
+  int cols_ = {0};
+  // Блок b, элемент (i, j), матрица b * kLanes + l:
+  // data_[b * BlockSize() + (i * cols_ + j) * kLanes + l]. Хвост последнего
+  // блока заполнен единичными (или нулевыми) матрицами.
+  std::pmr::vector<T> data_;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+using S21MatrixBatchF = S21BasicMatrixBatch<float>;
+using S21MatrixBatchLD = S21BasicMatrixBatch<long double>;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+extern template class S21BasicMatrixBatch<long double>;
+
+#endif  // S21_MATRIX_BATCH_H_
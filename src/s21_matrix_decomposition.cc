@@ -0,0 +1,278 @@
+#include "s21_matrix_decomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+
+// LU :
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T> &matrix)
+    : lu_(matrix), perm_(matrix.GetRows(), matrix.GetResource()) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+  const int n = lu_.rows_;
+  // Разложение доводится до конца без порога, чтобы определитель совпадал
+  // с S21BasicMatrix::Determinant(); порог нужен только для Solve().
+  sign_ = s21_kernels::LuDecompose(lu_.matrix_, n, lu_.stride_, perm_.data());
+  const T tolerance = s21_kernels::SingularTolerance(
+      matrix.matrix_, n, n, matrix.stride_);
+  singular_ = sign_ == 0;
+  for (int i = 0; i < n && !singular_; ++i) {
+    singular_ = std::fabs(lu_.Row(i)[i]) <= tolerance;
+  }
+}
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const noexcept {
+  T det = sign_;
+  for (int i = 0; i < lu_.rows_ && sign_ != 0; ++i) det *= lu_.Row(i)[i];
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  const int n = lu_.rows_;
+  if (b.GetRows() != n) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (singular_) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  if (!b.IsRowMajor()) {
+    return Solve(S21BasicMatrix<T>(b, lu_.resource_).View());
+  }
+  S21BasicMatrix<T> x(n, b.GetCols(), kS21Uninitialized, lu_.resource_);
+  s21_kernels::LuSolve(lu_.matrix_, n, lu_.stride_, perm_.data(), b.Data(),
+                       b.GetStride(), x.matrix_, x.stride_, x.cols_);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  if (singular_) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  const int n = lu_.rows_;
+  S21BasicMatrix<T> x(n, n, kS21Uninitialized, lu_.resource_);
+  s21_kernels::LuSolve<T>(lu_.matrix_, n, lu_.stride_, perm_.data(), nullptr,
+                          0, x.matrix_, x.stride_, n);
+  return x;
+}
+
+// Холецкий :
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrix<T> &matrix)
+    : l_(matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+  const int n = l_.rows_;
+  const T tolerance = s21_kernels::SingularTolerance(
+      matrix.matrix_, n, n, matrix.stride_);
+  // Построчно: l_ij = (a_ij - <l_i, l_j>) / l_jj, скалярные произведения
+  // идут по началам строк подряд. Верхний треугольник остаётся исходным и
+  // служит для проверки симметрии.
+  for (int i = 0; i < n; ++i) {
+    T *row_i = l_.Row(i);
+    for (int j = 0; j <= i; ++j) {
+      const T *row_j = l_.Row(j);
+      if (j < i && std::fabs(row_i[j] - row_j[i]) > tolerance) {
+        throw std::invalid_argument("Matrix is not symmetric");
+      }
+      T sum = row_i[j];
+      for (int k = 0; k < j; ++k) sum -= row_i[k] * row_j[k];
+      if (j < i) {
+        row_i[j] = sum / row_j[j];
+      } else if (sum > tolerance) {
+        row_i[i] = std::sqrt(sum);
+      } else {
+        throw std::invalid_argument("Matrix is not positive definite");
+      }
+    }
+  }
+}
+
+template <typename T>
+T S21BasicCholesky<T>::Determinant() const noexcept {
+  T det = 1;
+  for (int i = 0; i < l_.rows_; ++i) det *= l_.Row(i)[i];
+  return det * det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  if (b.GetRows() != l_.rows_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  S21BasicMatrix<T> x(b, l_.resource_);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Inverse() const {
+  S21BasicMatrix<T> x(l_.rows_, l_.rows_, l_.resource_);
+  for (int i = 0; i < x.rows_; ++i) x.Row(i)[i] = T(1);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+void S21BasicCholesky<T>::SolveInPlace(S21BasicMatrix<T> &x) const {
+  const int n = l_.rows_;
+  const int nrhs = x.cols_;
+  // L * Y = B прямой подстановкой.
+  for (int i = 0; i < n; ++i) {
+    const T *l_i = l_.Row(i);
+    T *x_i = x.Row(i);
+    for (int k = 0; k < i; ++k) {
+      const T *x_k = x.Row(k);
+      const T factor = l_i[k];
+      for (int j = 0; j < nrhs; ++j) x_i[j] -= factor * x_k[j];
+    }
+    s21_kernels::Scale(x_i, T(1) / l_i[i], nrhs);
+  }
+  // L^T * X = Y обратной подстановкой по строкам L, а не по столбцам.
+  for (int i = n - 1; i >= 0; --i) {
+    const T *l_i = l_.Row(i);
+    T *x_i = x.Row(i);
+    s21_kernels::Scale(x_i, T(1) / l_i[i], nrhs);
+    for (int k = 0; k < i; ++k) {
+      T *x_k = x.Row(k);
+      const T factor = l_i[k];
+      for (int j = 0; j < nrhs; ++j) x_k[j] -= factor * x_i[j];
+    }
+  }
+}
+
+// QR :
+
+template <typename T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrix<T> &matrix)
+    : qr_(matrix.GetResource()), tau_(matrix.GetResource()) {
+  const int m = matrix.rows_;
+  const int n = matrix.cols_;
+  if (m < n) {
+    throw std::invalid_argument("Matrix must have at least as many rows "
+                                "as cols");
+  }
+  qr_ = S21BasicMatrix<T>(n, m, kS21Uninitialized, qr_.resource_);
+  s21_kernels::Transpose(m, n, matrix.matrix_, matrix.stride_, qr_.matrix_,
+                         qr_.stride_);
+  tau_.assign(n, T(0));
+  const T tolerance =
+      s21_kernels::SingularTolerance(matrix.matrix_, m, n, matrix.stride_);
+  full_rank_ = true;
+  for (int j = 0; j < n; ++j) {
+    // Отражение H = I - tau * v * v^T, v = (1, a_j[j + 1..m)), переводит
+    // остаток j-го столбца в (beta, 0, ..., 0).
+    T *a_j = qr_.Row(j);
+    const T alpha = a_j[j];
+    T norm = alpha * alpha;
+    for (int i = j + 1; i < m; ++i) norm += a_j[i] * a_j[i];
+    norm = std::sqrt(norm);
+    if (norm != T(0)) {
+      const T beta = alpha > T(0) ? -norm : norm;
+      const T tau = (beta - alpha) / beta;
+      s21_kernels::Scale(a_j + j + 1, T(1) / (alpha - beta), m - j - 1);
+      a_j[j] = beta;
+      tau_[j] = tau;
+      for (int k = j + 1; k < n; ++k) {
+        T *a_k = qr_.Row(k);
+        T w = a_k[j];
+        for (int i = j + 1; i < m; ++i) w += a_j[i] * a_k[i];
+        w *= tau;
+        a_k[j] -= w;
+        for (int i = j + 1; i < m; ++i) a_k[i] -= w * a_j[i];
+      }
+    }
+    if (std::fabs(a_j[j]) <= tolerance) full_rank_ = false;
+  }
+}
+
+template <typename T>
+T S21BasicQR<T>::Determinant() const noexcept {
+  if (qr_.rows_ != qr_.cols_) return T(0);
+  // Каждое отражение меняет знак определителя.
+  T det = 1;
+  for (int j = 0; j < qr_.rows_; ++j) {
+    det *= tau_[j] != T(0) ? -qr_.Row(j)[j] : qr_.Row(j)[j];
+  }
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrixView<T> &b) const {
+  if (b.GetRows() != qr_.cols_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  S21BasicMatrix<T> x(b, qr_.resource_);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Inverse() const {
+  S21BasicMatrix<T> x(qr_.cols_, qr_.cols_, qr_.resource_);
+  for (int i = 0; i < x.rows_; ++i) x.Row(i)[i] = T(1);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+void S21BasicQR<T>::SolveInPlace(S21BasicMatrix<T> &x) const {
+  if (!full_rank_) {
+    throw std::invalid_argument("Matrix rank is deficient");
+  }
+  const int m = qr_.cols_;
+  const int n = qr_.rows_;
+  const int nrhs = x.cols_;
+  // Q^T * B: отражения применяются ко всем правым частям сразу, w - строка
+  // v^T * B.
+  std::pmr::vector<T> w(nrhs, qr_.resource_);
+  for (int j = 0; j < n; ++j) {
+    if (tau_[j] == T(0)) continue;
+    const T *v = qr_.Row(j);
+    T *x_j = x.Row(j);
+    std::copy(x_j, x_j + nrhs, w.begin());
+    for (int i = j + 1; i < m; ++i) {
+      const T *x_i = x.Row(i);
+      for (int c = 0; c < nrhs; ++c) w[c] += v[i] * x_i[c];
+    }
+    s21_kernels::Scale(w.data(), tau_[j], nrhs);
+    s21_kernels::Sub(x_j, w.data(), nrhs);
+    for (int i = j + 1; i < m; ++i) {
+      T *x_i = x.Row(i);
+      for (int c = 0; c < nrhs; ++c) x_i[c] -= v[i] * w[c];
+    }
+  }
+  // R * X = (Q^T * B)[0..n): j-я строка qr_ - это j-й столбец R.
+  for (int i = n - 1; i >= 0; --i) {
+    const T *r_i = qr_.Row(i);
+    T *x_i = x.Row(i);
+    s21_kernels::Scale(x_i, T(1) / r_i[i], nrhs);
+    for (int k = 0; k < i; ++k) {
+      T *x_k = x.Row(k);
+      const T factor = r_i[k];
+      for (int c = 0; c < nrhs; ++c) x_k[c] -= factor * x_i[c];
+    }
+  }
+  x.SetRows(n);
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
@@ -0,0 +1,107 @@
+#ifndef S21_MATRIX_DECOMPOSITION_H_
+#define S21_MATRIX_DECOMPOSITION_H_
+
+// Разложения, которые вычисляются один раз в конструкторе и затем
+// многократно используются: Determinant(), Solve() для любого числа правых
+// частей (столбцов B) и Inverse() не повторяют разложение.
+//
+// Шаблоны определены в s21_matrix_decomposition.cc и инстанцированы для
+// float, double и long double.
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// P * A = L * U с выбором ведущего элемента по столбцу для квадратной A.
+template <typename T>
+class S21BasicLU {
+ public:
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+
+  int GetSize() const noexcept { return lu_.GetRows(); }
+  // Ведущий элемент сравним с ошибкой округления (см. InverseMatrix).
+  bool IsSingular() const noexcept { return singular_; }
+  T Determinant() const noexcept;
+  // X из A * X = B, B - n x k; для вырожденной A бросает то же
+  // исключение, что и InverseMatrix().
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::pmr::vector<int> perm_;
+  int sign_ = 0;
+  bool singular_ = true;
+};
+
+// A = L * L^T для симметричной положительно определённой A: вдвое меньше
+// операций, чем у LU, и без перестановок. Для несимметричной или не
+// положительно определённой матрицы конструктор бросает
+// std::invalid_argument.
+template <typename T>
+class S21BasicCholesky {
+ public:
+  explicit S21BasicCholesky(const S21BasicMatrix<T>& matrix);
+
+  int GetSize() const noexcept { return l_.GetRows(); }
+  T Determinant() const noexcept;
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  // Заменяет правую часть x решением.
+  void SolveInPlace(S21BasicMatrix<T>& x) const;
+
+  // L хранится в нижнем треугольнике, верхний не используется.
+  S21BasicMatrix<T> l_;
+};
+
+// A = Q * R отражениями Хаусхолдера для A размера m x n, m >= n. Solve()
+// для m > n возвращает решение задачи наименьших квадратов
+// min ||A * X - B||, Inverse() - псевдообратную (A^T * A)^-1 * A^T.
+template <typename T>
+class S21BasicQR {
+ public:
+  explicit S21BasicQR(const S21BasicMatrix<T>& matrix);
+
+  int GetRows() const noexcept { return qr_.GetCols(); }
+  int GetCols() const noexcept { return qr_.GetRows(); }
+  // Все диагональные элементы R больше порога округления.
+  bool IsFullRank() const noexcept { return full_rank_; }
+  // Для неквадратной матрицы 0, как и S21BasicMatrix::Determinant().
+  T Determinant() const noexcept;
+  // B - m x k, результат - n x k; при неполном ранге бросает
+  // std::invalid_argument.
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  // Заменяет правую часть x (m x k) решением в первых n строках и
+  // уменьшает x до n x k.
+  void SolveInPlace(S21BasicMatrix<T>& x) const;
+
+  // Разложение хранится транспонированным (n x m), чтобы столбцы A,
+  // векторы отражений и столбцы R лежали подряд: в j-й строке правее
+  // диагонали - вектор j-го отражения без единичного первого элемента, на
+  // диагонали и левее - j-й столбец R.
+  S21BasicMatrix<T> qr_;
+  std::pmr::vector<T> tau_;
+  bool full_rank_ = false;
+};
+
+using S21LU = S21BasicLU<double>;
+using S21Cholesky = S21BasicCholesky<double>;
+using S21QR = S21BasicQR<double>;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+
+#endif  // S21_MATRIX_DECOMPOSITION_H_
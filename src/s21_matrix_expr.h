@@ -0,0 +1,345 @@
+#ifndef S21_MATRIX_EXPR_H_
+#define S21_MATRIX_EXPR_H_
+
+// Шаблоны выражений для поэлементной арифметики S21BasicMatrix.
+//
+// operator+, operator- и operator*(число) не вычисляют результат сразу, а
+// возвращают лёгкий объект-выражение со ссылками на операнды. Всё выражение
+// (например, a + b - c * 2.0) вычисляется одним проходом по буферу
+// результата при присваивании или конструировании матрицы, без
+// промежуточных матриц. Выражение ссылается на операнды, поэтому его не
+// следует сохранять дольше, чем живут эти матрицы (например, в auto).
+// Операнды одного выражения должны иметь один тип элементов. Матрица,
+// построенная из выражения, берёт память из ресурса первого операнда.
+
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const noexcept { return static_cast<const E&>(*this); }
+
+  int GetRows() const noexcept { return Self().GetRows(); }
+  int GetCols() const noexcept { return Self().GetCols(); }
+  // Ресурс первого операнда-матрицы, nullptr для одних представлений.
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return Self().GetResource();
+  }
+
+  template <typename T>
+  bool EqMatrix(const S21BasicMatrix<T>& other) const {
+    return S21BasicMatrix<T>(Self()).EqMatrix(other);
+  }
+  template <typename T>
+  bool operator==(const S21BasicMatrix<T>& other) const {
+    return EqMatrix(other);
+  }
+};
+
+// Лист выражения: представление вычисленной матрицы или её блока. Строка
+// листа - это просто указатель на начало строки в буфере.
+template <typename T>
+class S21MatrixLeaf : public S21MatrixExpr<S21MatrixLeaf<T>> {
+ public:
+  using Scalar = T;
+
+  explicit S21MatrixLeaf(
+      const S21BasicMatrixView<T>& view,
+      std::pmr::memory_resource* resource = nullptr) noexcept
+      : view_(view), resource_(resource) {}
+
+  int GetRows() const noexcept { return view_.GetRows(); }
+  int GetCols() const noexcept { return view_.GetCols(); }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return resource_;
+  }
+  // Буфер по столбцам читается поэлементно через At.
+  bool Conforming() const noexcept { return view_.IsRowMajor(); }
+  const T* Row(int i) const noexcept { return view_.Row(i); }
+  T At(int i, int j) const noexcept { return view_.At(i, j); }
+
+ private:
+  S21BasicMatrixView<T> view_;
+  std::pmr::memory_resource* resource_;
+};
+
+struct S21AddOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs + rhs;
+  }
+};
+
+struct S21SubOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs - rhs;
+  }
+};
+
+// Сумма или разность двух выражений. Как и SumMatrix/SubMatrix, при
+// несовпадении размеров операция не выполняется и результат равен lhs.
+template <typename L, typename R, typename Op>
+class S21MatrixBinary : public S21MatrixExpr<S21MatrixBinary<L, R, Op>> {
+ public:
+  using Scalar = typename L::Scalar;
+
+  S21MatrixBinary(const L& lhs, const R& rhs) noexcept
+      : lhs_(lhs),
+        rhs_(rhs),
+        same_size_(lhs.GetRows() == rhs.GetRows() &&
+                   lhs.GetCols() == rhs.GetCols()) {}
+
+  int GetRows() const noexcept { return lhs_.GetRows(); }
+  int GetCols() const noexcept { return lhs_.GetCols(); }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    std::pmr::memory_resource* resource = lhs_.GetResource();
+    return resource != nullptr ? resource : rhs_.GetResource();
+  }
+  bool Conforming() const noexcept {
+    return same_size_ && lhs_.Conforming() && rhs_.Conforming();
+  }
+
+  class RowCursor {
+   public:
+    RowCursor(decltype(std::declval<const L&>().Row(0)) lhs,
+              decltype(std::declval<const R&>().Row(0)) rhs) noexcept
+        : lhs_(lhs), rhs_(rhs) {}
+    Scalar operator[](int j) const noexcept {
+      return Op::Apply(Scalar(lhs_[j]), Scalar(rhs_[j]));
+    }
+
+   private:
+    decltype(std::declval<const L&>().Row(0)) lhs_;
+    decltype(std::declval<const R&>().Row(0)) rhs_;
+  };
+
+  RowCursor Row(int i) const noexcept {
+    return RowCursor(lhs_.Row(i), rhs_.Row(i));
+  }
+  Scalar At(int i, int j) const noexcept {
+    return same_size_ ? Op::Apply(lhs_.At(i, j), rhs_.At(i, j))
+                      : lhs_.At(i, j);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+  bool same_size_;
+};
+
+// Выражение, умноженное на число.
+template <typename E>
+class S21MatrixScaled : public S21MatrixExpr<S21MatrixScaled<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  S21MatrixScaled(const E& expr, Scalar num) noexcept
+      : expr_(expr), num_(num) {}
+
+  int GetRows() const noexcept { return expr_.GetRows(); }
+  int GetCols() const noexcept { return expr_.GetCols(); }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return expr_.GetResource();
+  }
+  bool Conforming() const noexcept { return expr_.Conforming(); }
+
+  class RowCursor {
+   public:
+    RowCursor(decltype(std::declval<const E&>().Row(0)) row,
+              Scalar num) noexcept
+        : row_(row), num_(num) {}
+    Scalar operator[](int j) const noexcept { return row_[j] * num_; }
+
+   private:
+    decltype(std::declval<const E&>().Row(0)) row_;
+    Scalar num_;
+  };
+
+  RowCursor Row(int i) const noexcept {
+    return RowCursor(expr_.Row(i), num_);
+  }
+  Scalar At(int i, int j) const noexcept { return expr_.At(i, j) * num_; }
+
+ private:
+  E expr_;
+  Scalar num_;
+};
+
+// Сопоставляет типу операнда (матрице или выражению) тип узла дерева;
+// для прочих типов Type не определён, и операторы ниже не участвуют
+// в разрешении перегрузки.
+template <typename T, typename = void>
+struct S21ExprTraits {};
+
+template <typename T>
+struct S21ExprTraits<S21BasicMatrix<T>> {
+  using Type = S21MatrixLeaf<T>;
+  static Type Wrap(const S21BasicMatrix<T>& matrix) noexcept {
+    return Type(matrix.View(), matrix.GetResource());
+  }
+};
+
+template <typename T>
+struct S21ExprTraits<S21BasicMatrixView<T>> {
+  using Type = S21MatrixLeaf<T>;
+  static Type Wrap(const S21BasicMatrixView<T>& view) noexcept {
+    return Type(view);
+  }
+};
+
+template <typename T>
+struct S21ExprTraits<
+    T, std::enable_if_t<std::is_base_of<S21MatrixExpr<T>, T>::value>> {
+  using Type = T;
+  static const T& Wrap(const T& expr) noexcept { return expr; }
+};
+
+template <typename T>
+using S21ExprOf = typename S21ExprTraits<T>::Type;
+
+// Тип узла для пары операндов с одинаковым типом элементов.
+template <typename L, typename R, typename Op>
+using S21BinaryOf = std::enable_if_t<
+    std::is_same<typename S21ExprOf<L>::Scalar,
+                 typename S21ExprOf<R>::Scalar>::value,
+    S21MatrixBinary<S21ExprOf<L>, S21ExprOf<R>, Op>>;
+
+template <typename L, typename R>
+S21BinaryOf<L, R, S21AddOp> operator+(const L& lhs, const R& rhs) noexcept {
+  return {S21ExprTraits<L>::Wrap(lhs), S21ExprTraits<R>::Wrap(rhs)};
+}
+
+template <typename L, typename R>
+S21BinaryOf<L, R, S21SubOp> operator-(const L& lhs, const R& rhs) noexcept {
+  return {S21ExprTraits<L>::Wrap(lhs), S21ExprTraits<R>::Wrap(rhs)};
+}
+
+// Предусмотрен случай, где число умножается на матрицу: num * matrix
+template <typename E>
+S21MatrixScaled<S21ExprOf<E>> operator*(
+    const E& expr, typename S21ExprOf<E>::Scalar num) noexcept {
+  return {S21ExprTraits<E>::Wrap(expr), num};
+}
+
+template <typename E>
+S21MatrixScaled<S21ExprOf<E>> operator*(typename S21ExprOf<E>::Scalar num,
+                                        const E& expr) noexcept {
+  return {S21ExprTraits<E>::Wrap(expr), num};
+}
+
+// Если операнд - временная матрица, результат пишется прямо в её буфер,
+// и (a * b) + c не выделяет памяти сверх самого произведения.
+template <typename T, typename R,
+          typename = S21BinaryOf<S21BasicMatrix<T>, R, S21AddOp>>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, const R& rhs) {
+  lhs = lhs + rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename L,
+          typename = S21BinaryOf<L, S21BasicMatrix<T>, S21AddOp>>
+S21BasicMatrix<T> operator+(const L& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs = lhs + rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  lhs = lhs + rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename R,
+          typename = S21BinaryOf<S21BasicMatrix<T>, R, S21SubOp>>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, const R& rhs) {
+  lhs = lhs - rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename L,
+          typename = S21BinaryOf<L, S21BasicMatrix<T>, S21SubOp>>
+S21BasicMatrix<T> operator-(const L& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  lhs = lhs - rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(
+    S21BasicMatrix<T>&& matrix,
+    typename S21BasicMatrix<T>::value_type num) noexcept {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(typename S21BasicMatrix<T>::value_type num,
+                            S21BasicMatrix<T>&& matrix) noexcept {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+// Матричное произведение не поэлементно: выражение вычисляется заранее.
+template <typename E, typename T>
+S21BasicMatrix<T> operator*(const S21MatrixExpr<E>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  S21BasicMatrix<T> result(lhs);
+  if (result.GetCols() != rhs.GetRows()) return result;
+  return result.View().MultiplyWith(rhs.View(), result.GetResource());
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : rows_(expr.GetRows()), cols_(expr.GetCols()) {
+  if (expr.GetResource() != nullptr) resource_ = expr.GetResource();
+  Allocate(false);
+  Assign(expr.Self());
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  if (rows_ == expr.GetRows() && cols_ == expr.GetCols()) {
+    // Поэлементное выражение читает (i, j) только для записи в (i, j),
+    // поэтому *this может входить в него операндом.
+    Assign(expr.Self());
+  } else {
+    S21BasicMatrix result(expr.GetRows(), expr.GetCols(), kS21Uninitialized,
+                          resource_);
+    result.Assign(expr.Self());
+    *this = std::move(result);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::Assign(const E& expr) {
+  if (expr.Conforming()) {
+    for (int i = 0; i < rows_; ++i) {
+      const auto src = expr.Row(i);
+      T* dst = Row(i);
+      for (int j = 0; j < cols_; ++j) dst[j] = src[j];
+    }
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      T* dst = Row(i);
+      for (int j = 0; j < cols_; ++j) dst[j] = expr.At(i, j);
+    }
+  }
+}
+
+#endif  // S21_MATRIX_EXPR_H_
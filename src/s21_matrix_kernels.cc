@@ -0,0 +1,1003 @@
+#include "s21_matrix_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_MATRIX_X86 1
+#include <immintrin.h>
+#else
+#define S21_MATRIX_X86 0
+#endif
+
+namespace s21_kernels {
+
+namespace {
+
+// Наибольший блок микроядра среди всех уровней и типов: под него
+// заводятся временные плитки на краях матрицы.
+constexpr int kMaxMr = 8;
+constexpr int kMaxNr = 32;
+// Блоки упаковки: kKc x nr полоса B помещается в L1, kMc x kKc панель A -
+// в L2, kKc x kNc панель B - в L3.
+constexpr int kMc = 128;
+constexpr int kKc = 256;
+constexpr int kNc = 2048;
+// Транспонирование рекурсивно делит матрицу пополам по большей стороне,
+// пока блок не станет не больше kTransposeBlock x kTransposeBlock: такой
+// блок источника и результата вместе помещаются в L1 при любом размере
+// кэша (cache-oblivious).
+constexpr int kTransposeBlock = 32;
+// Треугольные подстановки LuSolve идут полосами по kSolveBlock строк:
+// вклад уже решённых строк вычитается одним вызовом Gemm, и только
+// треугольник внутри полосы решается построчно.
+constexpr int kSolveBlock = 64;
+
+// Набор ядер одного уровня SIMD для типа T. Микроядро считает полную
+// mr x nr плитку C += alpha * A * B по упакованным полосам A (kc x mr) и
+// B (kc x nr).
+template <typename T>
+struct Kernels {
+  SimdLevel level;
+  int mr;
+  int nr;
+  void (*micro)(int kc, T alpha, const T* a, const T* b, T* c,
+                std::ptrdiff_t ldc);
+  void (*add)(T* dst, const T* src, std::ptrdiff_t n);
+  void (*sub)(T* dst, const T* src, std::ptrdiff_t n);
+  void (*scale)(T* dst, T num, std::ptrdiff_t n);
+  bool (*near)(const T* a, const T* b, std::ptrdiff_t n, T eps);
+  // dst (cols x rows) = src^T для блока не больше kTransposeBlock.
+  void (*transpose)(int rows, int cols, const T* src, std::ptrdiff_t lds,
+                    T* dst, std::ptrdiff_t ldd);
+};
+
+// Скалярные ядра: работают на любой платформе и для любого типа,
+// компилятор векторизует их под базовый набор инструкций сборки.
+
+template <typename T, int Mr, int Nr>
+void MicroKernelScalar(int kc, T alpha, const T* a, const T* b, T* c,
+                       std::ptrdiff_t ldc) {
+  T acc[Mr][Nr] = {};
+  for (int p = 0; p < kc; ++p) {
+#pragma GCC unroll 8
+    for (int i = 0; i < Mr; ++i) {
+      const T a_i = a[i];
+#pragma GCC unroll 8
+      for (int j = 0; j < Nr; ++j) acc[i][j] += a_i * b[j];
+    }
+    a += Mr;
+    b += Nr;
+  }
+  for (int i = 0; i < Mr; ++i) {
+    for (int j = 0; j < Nr; ++j) c[i * ldc + j] += alpha * acc[i][j];
+  }
+}
+
+template <typename T>
+void AddScalar(T* dst, const T* src, std::ptrdiff_t n) {
+  for (std::ptrdiff_t j = 0; j < n; ++j) dst[j] += src[j];
+}
+
+template <typename T>
+void SubScalar(T* dst, const T* src, std::ptrdiff_t n) {
+  for (std::ptrdiff_t j = 0; j < n; ++j) dst[j] -= src[j];
+}
+
+template <typename T>
+void ScaleScalar(T* dst, T num, std::ptrdiff_t n) {
+  for (std::ptrdiff_t j = 0; j < n; ++j) dst[j] *= num;
+}
+
+template <typename T>
+bool NearScalar(const T* a, const T* b, std::ptrdiff_t n, T eps) {
+  bool res = true;
+  for (std::ptrdiff_t j = 0; j < n && res; ++j) {
+    if (std::fabs(a[j] - b[j]) >= eps) res = false;
+  }
+  return res;
+}
+
+template <typename T>
+void TransposeScalar(int rows, int cols, const T* src, std::ptrdiff_t lds,
+                     T* dst, std::ptrdiff_t ldd) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) dst[j * ldd + i] = src[i * lds + j];
+  }
+}
+
+template <typename T>
+constexpr Kernels<T> kScalarKernels = {
+    SimdLevel::kScalar, 4,           8,           MicroKernelScalar<T, 4, 8>,
+    AddScalar<T>,       SubScalar<T>, ScaleScalar<T>, NearScalar<T>,
+    TransposeScalar<T>};
+
+#if S21_MATRIX_X86
+
+// Сравнения в AnyAbsGe упорядоченные: NaN, как и в std::fabs(...) >= eps,
+// не считается расхождением.
+
+namespace sse2 {
+
+#define S21_SIMD_TARGET __attribute__((target("sse2")))
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<double> {
+  using V = __m128d;
+  static constexpr int kWidth = 2;
+  S21_SIMD_TARGET static V Zero() { return _mm_setzero_pd(); }
+  S21_SIMD_TARGET static V Set1(double x) { return _mm_set1_pd(x); }
+  S21_SIMD_TARGET static V Load(const double* p) { return _mm_loadu_pd(p); }
+  S21_SIMD_TARGET static void Store(double* p, V v) { _mm_storeu_pd(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm_add_pd(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm_sub_pd(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm_mul_pd(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    V abs = _mm_andnot_pd(_mm_set1_pd(-0.0), diff);
+    return _mm_movemask_pd(_mm_cmpge_pd(abs, eps)) != 0;
+  }
+  // Транспонирует плитку kTile x kTile из src в dst.
+  static constexpr int kTile = 2;
+  S21_SIMD_TARGET static void TransposeTile(const double* src,
+                                            std::ptrdiff_t lds, double* dst,
+                                            std::ptrdiff_t ldd) {
+    V r0 = _mm_loadu_pd(src), r1 = _mm_loadu_pd(src + lds);
+    _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + ldd, _mm_unpackhi_pd(r0, r1));
+  }
+};
+
+template <>
+struct Ops<float> {
+  using V = __m128;
+  static constexpr int kWidth = 4;
+  S21_SIMD_TARGET static V Zero() { return _mm_setzero_ps(); }
+  S21_SIMD_TARGET static V Set1(float x) { return _mm_set1_ps(x); }
+  S21_SIMD_TARGET static V Load(const float* p) { return _mm_loadu_ps(p); }
+  S21_SIMD_TARGET static void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm_add_ps(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    V abs = _mm_andnot_ps(_mm_set1_ps(-0.0f), diff);
+    return _mm_movemask_ps(_mm_cmpge_ps(abs, eps)) != 0;
+  }
+  static constexpr int kTile = 4;
+  S21_SIMD_TARGET static void TransposeTile(const float* src,
+                                            std::ptrdiff_t lds, float* dst,
+                                            std::ptrdiff_t ldd) {
+    V r0 = _mm_loadu_ps(src), r1 = _mm_loadu_ps(src + lds);
+    V r2 = _mm_loadu_ps(src + 2 * lds), r3 = _mm_loadu_ps(src + 3 * lds);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + ldd, r1);
+    _mm_storeu_ps(dst + 2 * ldd, r2);
+    _mm_storeu_ps(dst + 3 * ldd, r3);
+  }
+};
+
+#include "s21_matrix_kernels_simd.inc"
+#undef S21_SIMD_TARGET
+
+}  // namespace sse2
+
+namespace avx2 {
+
+#define S21_SIMD_TARGET __attribute__((target("avx2,fma")))
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<double> {
+  using V = __m256d;
+  static constexpr int kWidth = 4;
+  S21_SIMD_TARGET static V Zero() { return _mm256_setzero_pd(); }
+  S21_SIMD_TARGET static V Set1(double x) { return _mm256_set1_pd(x); }
+  S21_SIMD_TARGET static V Load(const double* p) { return _mm256_loadu_pd(p); }
+  S21_SIMD_TARGET static void Store(double* p, V v) { _mm256_storeu_pd(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm256_add_pd(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm256_sub_pd(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm256_mul_pd(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    V abs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), diff);
+    return _mm256_movemask_pd(_mm256_cmp_pd(abs, eps, _CMP_GE_OQ)) != 0;
+  }
+  static constexpr int kTile = 4;
+  S21_SIMD_TARGET static void TransposeTile(const double* src,
+                                            std::ptrdiff_t lds, double* dst,
+                                            std::ptrdiff_t ldd) {
+    V r0 = Load(src), r1 = Load(src + lds);
+    V r2 = Load(src + 2 * lds), r3 = Load(src + 3 * lds);
+    V t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+    V t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+    Store(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    Store(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+    Store(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+    Store(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+
+template <>
+struct Ops<float> {
+  using V = __m256;
+  static constexpr int kWidth = 8;
+  S21_SIMD_TARGET static V Zero() { return _mm256_setzero_ps(); }
+  S21_SIMD_TARGET static V Set1(float x) { return _mm256_set1_ps(x); }
+  S21_SIMD_TARGET static V Load(const float* p) { return _mm256_loadu_ps(p); }
+  S21_SIMD_TARGET static void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    V abs = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), diff);
+    return _mm256_movemask_ps(_mm256_cmp_ps(abs, eps, _CMP_GE_OQ)) != 0;
+  }
+  static constexpr int kTile = 8;
+  S21_SIMD_TARGET static void TransposeTile(const float* src,
+                                            std::ptrdiff_t lds, float* dst,
+                                            std::ptrdiff_t ldd) {
+    V r[8], t[8];
+    for (int i = 0; i < 8; ++i) r[i] = Load(src + i * lds);
+    for (int i = 0; i < 8; i += 2) {
+      t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+      t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+      r[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+      r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xEE);
+      r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+      r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xEE);
+    }
+    for (int i = 0; i < 4; ++i) {
+      Store(dst + i * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+      Store(dst + (i + 4) * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+    }
+  }
+};
+
+#include "s21_matrix_kernels_simd.inc"
+#undef S21_SIMD_TARGET
+
+}  // namespace avx2
+
+namespace avx512 {
+
+#define S21_SIMD_TARGET __attribute__((target("avx512f")))
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<double> {
+  using V = __m512d;
+  static constexpr int kWidth = 8;
+  S21_SIMD_TARGET static V Zero() { return _mm512_setzero_pd(); }
+  S21_SIMD_TARGET static V Set1(double x) { return _mm512_set1_pd(x); }
+  S21_SIMD_TARGET static V Load(const double* p) { return _mm512_loadu_pd(p); }
+  S21_SIMD_TARGET static void Store(double* p, V v) { _mm512_storeu_pd(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm512_add_pd(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm512_sub_pd(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm512_mul_pd(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    return _mm512_cmp_pd_mask(_mm512_abs_pd(diff), eps, _CMP_GE_OQ) != 0;
+  }
+  // Плитки транспонирования те же, что у AVX2: 512-битные перестановки
+  // не дают выигрыша на блоках kTransposeBlock.
+  static constexpr int kTile = avx2::Ops<double>::kTile;
+  S21_SIMD_TARGET static void TransposeTile(const double* src,
+                                            std::ptrdiff_t lds, double* dst,
+                                            std::ptrdiff_t ldd) {
+    avx2::Ops<double>::TransposeTile(src, lds, dst, ldd);
+  }
+};
+
+template <>
+struct Ops<float> {
+  using V = __m512;
+  static constexpr int kWidth = 16;
+  S21_SIMD_TARGET static V Zero() { return _mm512_setzero_ps(); }
+  S21_SIMD_TARGET static V Set1(float x) { return _mm512_set1_ps(x); }
+  S21_SIMD_TARGET static V Load(const float* p) { return _mm512_loadu_ps(p); }
+  S21_SIMD_TARGET static void Store(float* p, V v) { _mm512_storeu_ps(p, v); }
+  S21_SIMD_TARGET static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+  S21_SIMD_TARGET static V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+  S21_SIMD_TARGET static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+  S21_SIMD_TARGET static V MulAdd(V a, V b, V c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+  S21_SIMD_TARGET static bool AnyAbsGe(V diff, V eps) {
+    return _mm512_cmp_ps_mask(_mm512_abs_ps(diff), eps, _CMP_GE_OQ) != 0;
+  }
+  static constexpr int kTile = avx2::Ops<float>::kTile;
+  S21_SIMD_TARGET static void TransposeTile(const float* src,
+                                            std::ptrdiff_t lds, float* dst,
+                                            std::ptrdiff_t ldd) {
+    avx2::Ops<float>::TransposeTile(src, lds, dst, ldd);
+  }
+};
+
+#include "s21_matrix_kernels_simd.inc"
+#undef S21_SIMD_TARGET
+
+}  // namespace avx512
+
+// Размер плитки: SSE2 - 4 строки x 2 вектора, AVX2 - 6 x 2 (12
+// аккумуляторов из 16 регистров), AVX-512 - 8 x 2 (16 из 32).
+
+template <typename T>
+constexpr Kernels<T> kSse2Kernels = {
+    SimdLevel::kSse2,           4,
+    2 * sse2::Ops<T>::kWidth,   sse2::MicroKernel<T, 4, 2>,
+    sse2::Add<T>,               sse2::Sub<T>,
+    sse2::Scale<T>,             sse2::Near<T>,
+    sse2::Transpose<T>};
+
+template <typename T>
+constexpr Kernels<T> kAvx2Kernels = {
+    SimdLevel::kAvx2,           6,
+    2 * avx2::Ops<T>::kWidth,   avx2::MicroKernel<T, 6, 2>,
+    avx2::Add<T>,               avx2::Sub<T>,
+    avx2::Scale<T>,             avx2::Near<T>,
+    avx2::Transpose<T>};
+
+template <typename T>
+constexpr Kernels<T> kAvx512Kernels = {
+    SimdLevel::kAvx512,         8,
+    2 * avx512::Ops<T>::kWidth, avx512::MicroKernel<T, 8, 2>,
+    avx512::Add<T>,             avx512::Sub<T>,
+    avx512::Scale<T>,           avx512::Near<T>,
+    avx512::Transpose<T>};
+
+#endif  // S21_MATRIX_X86
+
+SimdLevel DetectLevel() noexcept {
+  SimdLevel level = SimdLevel::kScalar;
+#if S21_MATRIX_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    level = SimdLevel::kAvx512;
+  } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    level = SimdLevel::kAvx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    level = SimdLevel::kSse2;
+  }
+#endif
+  return level;
+}
+
+SimdLevel DetectedLevel() noexcept {
+  static const SimdLevel detected = DetectLevel();
+  return detected;
+}
+
+SimdLevel InitialLevel() noexcept {
+  SimdLevel level = DetectedLevel();
+  const char* env = std::getenv("S21_MATRIX_SIMD");
+  if (env != nullptr) {
+    if (std::strcmp(env, "scalar") == 0) {
+      level = SimdLevel::kScalar;
+    } else if (std::strcmp(env, "sse2") == 0) {
+      level = std::min(level, SimdLevel::kSse2);
+    } else if (std::strcmp(env, "avx2") == 0) {
+      level = std::min(level, SimdLevel::kAvx2);
+    } else if (std::strcmp(env, "avx512") == 0) {
+      level = std::min(level, SimdLevel::kAvx512);
+    }
+  }
+  return level;
+}
+
+std::atomic<SimdLevel>& ActiveLevel() noexcept {
+  static std::atomic<SimdLevel> level{InitialLevel()};
+  return level;
+}
+
+std::atomic<int>& StrassenCrossover() noexcept {
+  static std::atomic<int> crossover{[] {
+    const char* env = std::getenv("S21_MATRIX_STRASSEN");
+    return env != nullptr ? std::max(0, std::atoi(env)) : 0;
+  }()};
+  return crossover;
+}
+
+template <typename T>
+const Kernels<T>& Active() noexcept {
+  const Kernels<T>* kernels = &kScalarKernels<T>;
+#if S21_MATRIX_X86
+  if constexpr (std::is_same<T, float>::value ||
+                std::is_same<T, double>::value) {
+    switch (ActiveLevel().load(std::memory_order_relaxed)) {
+      case SimdLevel::kAvx512:
+        kernels = &kAvx512Kernels<T>;
+        break;
+      case SimdLevel::kAvx2:
+        kernels = &kAvx2Kernels<T>;
+        break;
+      case SimdLevel::kSse2:
+        kernels = &kSse2Kernels<T>;
+        break;
+      case SimdLevel::kScalar:
+        break;
+    }
+  }
+#endif
+  return *kernels;
+}
+
+int RoundUp(int value, int step) { return (value + step - 1) / step * step; }
+
+// Копирует блок A (mc x kc) полосами по mr строк: внутри полосы элементы
+// одного столбца лежат подряд, недостающие строки дополняются нулями.
+template <typename T>
+void PackA(int mc, int kc, int mr, const T* a, std::ptrdiff_t a_row,
+           std::ptrdiff_t a_col, T* dst) {
+  for (int i = 0; i < mc; i += mr) {
+    const int rows = std::min(mr, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      const T* src = a + i * a_row + p * a_col;
+      for (int r = 0; r < rows; ++r) dst[r] = src[r * a_row];
+      for (int r = rows; r < mr; ++r) dst[r] = T(0);
+      dst += mr;
+    }
+  }
+}
+
+// Копирует блок B (kc x nc) полосами по nr столбцов.
+template <typename T>
+void PackB(int kc, int nc, int nr, const T* b, std::ptrdiff_t b_row,
+           std::ptrdiff_t b_col, T* dst) {
+  for (int j = 0; j < nc; j += nr) {
+    const int cols = std::min(nr, nc - j);
+    for (int p = 0; p < kc; ++p) {
+      const T* src = b + p * b_row + j * b_col;
+      for (int c = 0; c < cols; ++c) dst[c] = src[c * b_col];
+      for (int c = cols; c < nr; ++c) dst[c] = T(0);
+      dst += nr;
+    }
+  }
+}
+
+// C[0:rows, 0:cols] *= beta; при beta == 0 - обнуление.
+template <typename T>
+void ScaleTile(int rows, int cols, T beta, T* c, std::ptrdiff_t ldc) {
+  if (beta == T(1)) return;
+  for (int i = 0; i < rows; ++i) {
+    T* c_i = c + i * ldc;
+    if (beta == T(0)) {
+      std::fill(c_i, c_i + cols, T(0));
+    } else {
+      Active<T>().scale(c_i, beta, cols);
+    }
+  }
+}
+
+template <typename T>
+void GemmSmall(int m, int n, int k, T alpha, const T* a, std::ptrdiff_t a_row,
+               std::ptrdiff_t a_col, const T* b, std::ptrdiff_t b_row,
+               std::ptrdiff_t b_col, T beta, T* c, std::ptrdiff_t ldc) {
+  for (int i = 0; i < m; ++i) {
+    T* c_i = c + i * ldc;
+    ScaleTile(1, n, beta, c_i, ldc);
+    for (int p = 0; p < k; ++p) {
+      const T a_ip = alpha * a[i * a_row + p * a_col];
+      const T* b_p = b + p * b_row;
+      for (int j = 0; j < n; ++j) c_i[j] += a_ip * b_p[j * b_col];
+    }
+  }
+}
+
+// Считает C[0:mc, jr_begin:jr_end] = alpha * A[0:mc, 0:kc] * B + beta * C,
+// где B уже упакована (PackB), а блок A упаковывается в буфер текущего
+// потока. Плитка C умножается на beta прямо перед микроядром.
+template <typename T>
+void GemmPanel(const Kernels<T>& kernels, int mc, int kc, int jr_begin,
+               int jr_end, T alpha, const T* a, std::ptrdiff_t a_row,
+               std::ptrdiff_t a_col, const T* packed_b, T beta, T* c,
+               std::ptrdiff_t ldc) {
+  const int mr = kernels.mr;
+  const int nr = kernels.nr;
+  thread_local std::vector<T> packed_a;
+  packed_a.resize(static_cast<std::size_t>(RoundUp(kMc, mr)) * kKc);
+  PackA(mc, kc, mr, a, a_row, a_col, packed_a.data());
+  for (int jr = jr_begin; jr < jr_end; jr += nr) {
+    for (int ir = 0; ir < mc; ir += mr) {
+      const T* pa = packed_a.data() + ir * kc;
+      const T* pb = packed_b + jr * kc;
+      T* c_tile = c + ir * ldc + jr;
+      const int rows = std::min(mr, mc - ir);
+      const int cols = std::min(nr, jr_end - jr);
+      ScaleTile(rows, cols, beta, c_tile, ldc);
+      if (rows == mr && cols == nr) {
+        kernels.micro(kc, alpha, pa, pb, c_tile, ldc);
+      } else {
+        // Край матрицы: полная плитка считается во временный буфер.
+        T tile[kMaxMr * kMaxNr] = {};
+        kernels.micro(kc, alpha, pa, pb, tile, nr);
+        for (int i = 0; i < rows; ++i) {
+          for (int j = 0; j < cols; ++j) {
+            c_tile[i * ldc + j] += tile[i * nr + j];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void TransposeRecursive(const Kernels<T>& kernels, int rows, int cols,
+                        const T* src, std::ptrdiff_t lds, T* dst,
+                        std::ptrdiff_t ldd) {
+  if (rows <= kTransposeBlock && cols <= kTransposeBlock) {
+    kernels.transpose(rows, cols, src, lds, dst, ldd);
+  } else if (rows >= cols) {
+    // Граница кратна 8, чтобы плитки микроядра не резались.
+    const int half = RoundUp(rows / 2, 8);
+    TransposeRecursive(kernels, half, cols, src, lds, dst, ldd);
+    TransposeRecursive(kernels, rows - half, cols, src + half * lds, lds,
+                       dst + half, ldd);
+  } else {
+    const int half = RoundUp(cols / 2, 8);
+    TransposeRecursive(kernels, rows, half, src, lds, dst, ldd);
+    TransposeRecursive(kernels, rows, cols - half, src + half,
+                       lds, dst + half * ldd, ldd);
+  }
+}
+
+}  // namespace
+
+SimdLevel GetSimdLevel() noexcept {
+  return ActiveLevel().load(std::memory_order_relaxed);
+}
+
+SimdLevel SetSimdLevel(SimdLevel level) noexcept {
+  level = std::min(level, DetectedLevel());
+  ActiveLevel().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+int GetStrassenCrossover() noexcept {
+  return StrassenCrossover().load(std::memory_order_relaxed);
+}
+
+void SetStrassenCrossover(int n) noexcept {
+  StrassenCrossover().store(std::max(0, n), std::memory_order_relaxed);
+}
+
+template <typename T>
+void Add(T* dst, const T* src, std::ptrdiff_t n) noexcept {
+  Active<T>().add(dst, src, n);
+}
+
+template <typename T>
+void Sub(T* dst, const T* src, std::ptrdiff_t n) noexcept {
+  Active<T>().sub(dst, src, n);
+}
+
+template <typename T>
+void Scale(T* dst, T num, std::ptrdiff_t n) noexcept {
+  Active<T>().scale(dst, num, n);
+}
+
+template <typename T>
+bool Near(const T* a, const T* b, std::ptrdiff_t n, T eps) noexcept {
+  return Active<T>().near(a, b, n, eps);
+}
+
+template <typename T>
+void Transpose(int rows, int cols, const T* src, std::ptrdiff_t lds, T* dst,
+               std::ptrdiff_t ldd) noexcept {
+  if (rows > 0 && cols > 0) {
+    TransposeRecursive(Active<T>(), rows, cols, src, lds, dst, ldd);
+  }
+}
+
+template <typename T>
+void TransposeInPlace(int n, T* a, std::ptrdiff_t lda) noexcept {
+  const Kernels<T>& kernels = Active<T>();
+  // Пара симметричных блоков меняется местами через одну плитку на стеке.
+  T tile[kTransposeBlock * kTransposeBlock];
+  for (int ib = 0; ib < n; ib += kTransposeBlock) {
+    const int rows = std::min(kTransposeBlock, n - ib);
+    T* diagonal = a + ib * lda + ib;
+    for (int i = 0; i < rows; ++i) {
+      for (int j = i + 1; j < rows; ++j) {
+        std::swap(diagonal[i * lda + j], diagonal[j * lda + i]);
+      }
+    }
+    for (int jb = ib + kTransposeBlock; jb < n; jb += kTransposeBlock) {
+      const int cols = std::min(kTransposeBlock, n - jb);
+      T* upper = a + ib * lda + jb;
+      T* lower = a + jb * lda + ib;
+      kernels.transpose(rows, cols, upper, lda, tile, rows);
+      kernels.transpose(cols, rows, lower, lda, upper, lda);
+      for (int i = 0; i < cols; ++i) {
+        std::copy(tile + i * rows, tile + (i + 1) * rows, lower + i * lda);
+      }
+    }
+  }
+}
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, std::ptrdiff_t a_row,
+          std::ptrdiff_t a_col, const T* b, std::ptrdiff_t b_row,
+          std::ptrdiff_t b_col, T* c, std::ptrdiff_t ldc) {
+  Gemm(m, n, k, alpha, a, a_row, a_col, b, b_row, b_col, T(1), c, ldc);
+}
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, std::ptrdiff_t a_row,
+          std::ptrdiff_t a_col, const T* b, std::ptrdiff_t b_row,
+          std::ptrdiff_t b_col, T beta, T* c, std::ptrdiff_t ldc) {
+  if (m <= 0 || n <= 0) return;
+  const std::ptrdiff_t volume = static_cast<std::ptrdiff_t>(m) * n * k;
+  if (volume <= kGemmSmallSize) {
+    GemmSmall(m, n, k, alpha, a, a_row, a_col, b, b_row, b_col, beta, c,
+              ldc);
+    return;
+  }
+  const Kernels<T>& kernels = Active<T>();
+  const int mr = kernels.mr;
+  const int nr = kernels.nr;
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int threads = volume >= kGemmParallelSize ? pool.GetThreadCount() : 1;
+  // Панель B упаковывается один раз на (jc, pc) и общая для всех потоков.
+  thread_local std::vector<T> packed_b;
+  packed_b.resize(static_cast<std::size_t>(kKc) * RoundUp(kNc, nr));
+
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    // Плитки C: полосы строк по mc_block и куски столбцов по nc_block,
+    // чтобы задач хватило на все потоки.
+    int mc_block = RoundUp(kMc, mr);
+    if (threads > 1) {
+      mc_block = std::min(mc_block, RoundUp((m + threads - 1) / threads, mr));
+    }
+    const int row_blocks = (m + mc_block - 1) / mc_block;
+    int col_blocks = 1;
+    while (row_blocks * col_blocks < threads && nc / (col_blocks * 2) >= nr) {
+      col_blocks *= 2;
+    }
+    const int nc_block = RoundUp((nc + col_blocks - 1) / col_blocks, nr);
+    col_blocks = (nc + nc_block - 1) / nc_block;
+
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      PackB(kc, nc, nr, b + pc * b_row + jc * b_col, b_row, b_col,
+            packed_b.data());
+      const T* pb = packed_b.data();
+      auto tile = [&](int t) {
+        const int ic = (t / col_blocks) * mc_block;
+        const int jr_begin = (t % col_blocks) * nc_block;
+        GemmPanel(kernels, std::min(mc_block, m - ic), kc, jr_begin,
+                  std::min(nc, jr_begin + nc_block), alpha,
+                  a + ic * a_row + pc * a_col, a_row, a_col, pb,
+                  pc == 0 ? beta : T(1), c + ic * ldc + jc, ldc);
+      };
+      pool.ParallelFor(row_blocks * col_blocks, tile);
+    }
+  }
+}
+
+// LU-разложение квадратной матрицы n x n на месте с частичным выбором
+// ведущего элемента по столбцу: после вызова ниже диагонали лежит L (без
+// единичной диагонали), на диагонали и выше - U, perm[i] - исходный номер
+// i-й строки. Возвращает знак перестановки или 0, если модуль ведущего
+// элемента не превышает tolerance (матрица вырождена).
+template <typename T>
+int LuDecompose(T* a, int n, int stride, int* perm, T tolerance) {
+  int sign = 1;
+  for (int i = 0; i < n; ++i) perm[i] = i;
+  for (int k = 0; k < n && sign != 0; ++k) {
+    T* row_k = a + static_cast<std::ptrdiff_t>(k) * stride;
+    int pivot = k;
+    T max = std::fabs(row_k[k]);
+    for (int i = k + 1; i < n; ++i) {
+      T value = std::fabs(a[static_cast<std::ptrdiff_t>(i) * stride + k]);
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    if (max <= tolerance) {
+      sign = 0;
+    } else {
+      if (pivot != k) {
+        std::swap_ranges(row_k, row_k + n,
+                         a + static_cast<std::ptrdiff_t>(pivot) * stride);
+        std::swap(perm[k], perm[pivot]);
+        sign = -sign;
+      }
+      for (int i = k + 1; i < n; ++i) {
+        T* row_i = a + static_cast<std::ptrdiff_t>(i) * stride;
+        T factor = row_i[k] / row_k[k];
+        row_i[k] = factor;
+        for (int j = k + 1; j < n; ++j) {
+          row_i[j] -= factor * row_k[j];
+        }
+      }
+    }
+  }
+  return sign;
+}
+
+namespace {
+
+// dst = x + sign * y для блоков n x n.
+template <typename T>
+void Combine(const Kernels<T>& kernels, int n, const T* x, std::ptrdiff_t ldx,
+             const T* y, std::ptrdiff_t ldy, bool subtract, T* dst,
+             std::ptrdiff_t ldd) noexcept {
+  for (int i = 0; i < n; ++i) {
+    T* d = dst + i * ldd;
+    std::copy(x + i * ldx, x + i * ldx + n, d);
+    if (subtract) {
+      kernels.sub(d, y + i * ldy, n);
+    } else {
+      kernels.add(d, y + i * ldy, n);
+    }
+  }
+}
+
+// dst += sign * src для блоков n x n.
+template <typename T>
+void Accumulate(const Kernels<T>& kernels, int n, const T* src,
+                std::ptrdiff_t lds, bool subtract, T* dst,
+                std::ptrdiff_t ldd) noexcept {
+  for (int i = 0; i < n; ++i) {
+    if (subtract) {
+      kernels.sub(dst + i * ldd, src + i * lds, n);
+    } else {
+      kernels.add(dst + i * ldd, src + i * lds, n);
+    }
+  }
+}
+
+// C = A * B для n x n по Штрассену-Винограду: 7 умножений половинного
+// размера и 15 сложений вместо 8 умножений. Нечётный n отщепляет последнюю
+// строку и столбец, которые досчитываются через Gemm.
+template <typename T>
+void StrassenRecursive(int n, int crossover, const T* a, std::ptrdiff_t lda,
+                       const T* b, std::ptrdiff_t ldb, T* c,
+                       std::ptrdiff_t ldc) {
+  if (n < crossover) {
+    for (int i = 0; i < n; ++i) std::fill(c + i * ldc, c + i * ldc + n, T(0));
+    Gemm(n, n, n, T(1), a, lda, 1, b, ldb, 1, c, ldc);
+    return;
+  }
+  if (n % 2 != 0) {
+    const int m = n - 1;
+    StrassenRecursive(m, crossover, a, lda, b, ldb, c, ldc);
+    for (int i = 0; i < m; ++i) c[i * ldc + m] = T(0);
+    std::fill(c + m * ldc, c + m * ldc + n, T(0));
+    // C11 += a12 * b21, последний столбец и последняя строка C.
+    Gemm(m, m, 1, T(1), a + m, lda, 1, b + m * ldb, ldb, 1, c, ldc);
+    Gemm(m, 1, n, T(1), a, lda, 1, b + m, ldb, 1, c + m, ldc);
+    Gemm(1, n, n, T(1), a + m * lda, lda, 1, b, ldb, 1, c + m * ldc, ldc);
+    return;
+  }
+  const Kernels<T>& kernels = Active<T>();
+  const int h = n / 2;
+  const T *a11 = a, *a12 = a + h, *a21 = a + h * lda, *a22 = a21 + h;
+  const T *b11 = b, *b12 = b + h, *b21 = b + h * ldb, *b22 = b21 + h;
+  T *c11 = c, *c12 = c + h, *c21 = c + h * ldc, *c22 = c21 + h;
+  // Три временных блока h x h: суммы S, T и произведение X.
+  std::vector<T> buffer(static_cast<std::size_t>(3) * h * h);
+  T* s = buffer.data();
+  T* t = s + h * h;
+  T* x = t + h * h;
+  // P5 = (A21 + A22)(B12 - B11) в C22.
+  Combine(kernels, h, a21, lda, a22, lda, false, s, h);
+  Combine(kernels, h, b12, ldb, b11, ldb, true, t, h);
+  StrassenRecursive(h, crossover, s, h, t, h, c22, ldc);
+  // P6 = (S - A11)(B22 - T) в C12; X пока свободен.
+  Accumulate(kernels, h, a11, lda, true, s, h);
+  Combine(kernels, h, b22, ldb, t, h, true, x, h);
+  StrassenRecursive(h, crossover, s, h, x, h, c12, ldc);
+  // P7 = (A11 - A21)(B22 - B12) в C21.
+  Combine(kernels, h, a11, lda, a21, lda, true, s, h);
+  Combine(kernels, h, b22, ldb, b12, ldb, true, t, h);
+  StrassenRecursive(h, crossover, s, h, t, h, c21, ldc);
+  // P1 = A11 * B11; C11 = P1 + P2, P2 = A12 * B21.
+  StrassenRecursive(h, crossover, a11, lda, b11, ldb, x, h);
+  Accumulate(kernels, h, x, h, false, c12, ldc);    // U2 = P1 + P6
+  Accumulate(kernels, h, c12, ldc, false, c21, ldc);  // U3 = U2 + P7
+  Accumulate(kernels, h, c22, ldc, false, c12, ldc);  // U4 = U2 + P5
+  Accumulate(kernels, h, c21, ldc, false, c22, ldc);  // C22 = U3 + P5
+  StrassenRecursive(h, crossover, a12, lda, b21, ldb, c11, ldc);
+  Accumulate(kernels, h, x, h, false, c11, ldc);
+  // C12 = U4 + P3, P3 = (A12 - A21 - A22 + A11) * B22.
+  Combine(kernels, h, a12, lda, a21, lda, true, s, h);
+  Accumulate(kernels, h, a22, lda, true, s, h);
+  Accumulate(kernels, h, a11, lda, false, s, h);
+  StrassenRecursive(h, crossover, s, h, b22, ldb, x, h);
+  Accumulate(kernels, h, x, h, false, c12, ldc);
+  // C21 = U3 - P4, P4 = A22 * (B22 - B12 + B11 - B21).
+  Combine(kernels, h, b22, ldb, b12, ldb, true, t, h);
+  Accumulate(kernels, h, b11, ldb, false, t, h);
+  Accumulate(kernels, h, b21, ldb, true, t, h);
+  StrassenRecursive(h, crossover, a22, lda, t, h, x, h);
+  Accumulate(kernels, h, x, h, true, c21, ldc);
+}
+
+}  // namespace
+
+template <typename T>
+void Strassen(int n, const T* a, std::ptrdiff_t lda, const T* b,
+              std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc) {
+  // Листья не меньше 32, иначе сложения дороже сэкономленного умножения.
+  const int crossover = std::max(GetStrassenCrossover(), 32);
+  if (n > 0) StrassenRecursive(n, crossover, a, lda, b, ldb, c, ldc);
+}
+
+// Решает A * X = B по результату LuDecompose, B и X размера n x nrhs;
+// b == nullptr означает единичную правую часть. Все правые части
+// обрабатываются за один проход, подстановки идут целыми строками X.
+template <typename T>
+void LuSolve(const T* lu, int n, int lu_stride, const int* perm,
+             const T* b, int b_stride, T* x, int x_stride, int nrhs) {
+  for (int i = 0; i < n; ++i) {
+    T* x_i = x + static_cast<std::ptrdiff_t>(i) * x_stride;
+    if (b == nullptr) {
+      std::fill(x_i, x_i + nrhs, T(0));
+      x_i[perm[i]] = T(1);
+    } else {
+      const T* b_i = b + static_cast<std::ptrdiff_t>(perm[i]) * b_stride;
+      std::copy(b_i, b_i + nrhs, x_i);
+    }
+  }
+  // L * Y = P * B: X[ib, ie) -= L[ib, ie)[0, ib) * X[0, ib).
+  for (int ib = 0; ib < n; ib += kSolveBlock) {
+    const int ie = std::min(n, ib + kSolveBlock);
+    const T* l_b = lu + static_cast<std::ptrdiff_t>(ib) * lu_stride;
+    Gemm(ie - ib, nrhs, ib, T(-1), l_b, lu_stride, 1, x, x_stride, 1,
+         x + static_cast<std::ptrdiff_t>(ib) * x_stride, x_stride);
+    for (int i = ib; i < ie; ++i) {
+      T* x_i = x + static_cast<std::ptrdiff_t>(i) * x_stride;
+      const T* l_i = lu + static_cast<std::ptrdiff_t>(i) * lu_stride;
+      for (int k = ib; k < i; ++k) {
+        const T* x_k = x + static_cast<std::ptrdiff_t>(k) * x_stride;
+        const T factor = l_i[k];
+        for (int j = 0; j < nrhs; ++j) x_i[j] -= factor * x_k[j];
+      }
+    }
+  }
+  // U * X = Y: X[ib, ie) -= U[ib, ie)[ie, n) * X[ie, n).
+  for (int ie = n; ie > 0; ie -= kSolveBlock) {
+    const int ib = std::max(0, ie - kSolveBlock);
+    const T* u_b = lu + static_cast<std::ptrdiff_t>(ib) * lu_stride;
+    Gemm(ie - ib, nrhs, n - ie, T(-1), u_b + ie, lu_stride, 1,
+         x + static_cast<std::ptrdiff_t>(ie) * x_stride, x_stride, 1,
+         x + static_cast<std::ptrdiff_t>(ib) * x_stride, x_stride);
+    for (int i = ie - 1; i >= ib; --i) {
+      T* x_i = x + static_cast<std::ptrdiff_t>(i) * x_stride;
+      const T* u_i = lu + static_cast<std::ptrdiff_t>(i) * lu_stride;
+      for (int k = i + 1; k < ie; ++k) {
+        const T* x_k = x + static_cast<std::ptrdiff_t>(k) * x_stride;
+        const T factor = u_i[k];
+        for (int j = 0; j < nrhs; ++j) x_i[j] -= factor * x_k[j];
+      }
+      const T inv = T(1) / u_i[i];
+      for (int j = 0; j < nrhs; ++j) x_i[j] *= inv;
+    }
+  }
+}
+
+// LU-разложение с полным выбором ведущего элемента: P * A * Q = L * U,
+// row_perm[i] и col_perm[j] - исходные номера i-й строки и j-го столбца.
+// Останавливается, когда все оставшиеся элементы не больше tolerance, и
+// возвращает найденный ранг; *sign - знак det(P) * det(Q).
+template <typename T>
+int LuDecomposeFull(T* a, int n, int stride, int* row_perm, int* col_perm,
+                    T tolerance, int* sign) {
+  *sign = 1;
+  for (int i = 0; i < n; ++i) row_perm[i] = col_perm[i] = i;
+  int rank = 0;
+  for (int k = 0; k < n && rank == k; ++k) {
+    int pivot_row = k, pivot_col = k;
+    T max = T(0);
+    for (int i = k; i < n; ++i) {
+      const T* row_i = a + static_cast<std::ptrdiff_t>(i) * stride;
+      for (int j = k; j < n; ++j) {
+        if (std::fabs(row_i[j]) > max) {
+          max = std::fabs(row_i[j]);
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (max > tolerance) {
+      T* row_k = a + static_cast<std::ptrdiff_t>(k) * stride;
+      if (pivot_row != k) {
+        std::swap_ranges(row_k, row_k + n,
+                         a + static_cast<std::ptrdiff_t>(pivot_row) * stride);
+        std::swap(row_perm[k], row_perm[pivot_row]);
+        *sign = -*sign;
+      }
+      if (pivot_col != k) {
+        for (int i = 0; i < n; ++i) {
+          T* row_i = a + static_cast<std::ptrdiff_t>(i) * stride;
+          std::swap(row_i[k], row_i[pivot_col]);
+        }
+        std::swap(col_perm[k], col_perm[pivot_col]);
+        *sign = -*sign;
+      }
+      for (int i = k + 1; i < n; ++i) {
+        T* row_i = a + static_cast<std::ptrdiff_t>(i) * stride;
+        T factor = row_i[k] / row_k[k];
+        row_i[k] = factor;
+        for (int j = k + 1; j < n; ++j) row_i[j] -= factor * row_k[j];
+      }
+      ++rank;
+    }
+  }
+  return rank;
+}
+
+// Порог вырожденности для LU: ведущий элемент, сравнимый с ошибкой
+// округления n * eps * max|a_ij|, считается нулевым.
+template <typename T>
+T SingularTolerance(const T* a, int rows, int cols, int stride) {
+  T max = T(0);
+  for (int i = 0; i < rows; ++i) {
+    const T* row = a + static_cast<std::ptrdiff_t>(i) * stride;
+    for (int j = 0; j < cols; ++j) max = std::max(max, std::fabs(row[j]));
+  }
+  return rows * std::numeric_limits<T>::epsilon() * max;
+}
+
+#define S21_INSTANTIATE_KERNELS(T)                                          \
+  template void Add<T>(T*, const T*, std::ptrdiff_t) noexcept;              \
+  template void Sub<T>(T*, const T*, std::ptrdiff_t) noexcept;              \
+  template void Scale<T>(T*, T, std::ptrdiff_t) noexcept;                   \
+  template bool Near<T>(const T*, const T*, std::ptrdiff_t, T) noexcept;    \
+  template void Transpose<T>(int, int, const T*, std::ptrdiff_t, T*,         \
+                             std::ptrdiff_t) noexcept;                      \
+  template void TransposeInPlace<T>(int, T*, std::ptrdiff_t) noexcept;      \
+  template void Gemm<T>(int, int, int, T, const T*, std::ptrdiff_t,         \
+                        std::ptrdiff_t, const T*, std::ptrdiff_t,           \
+                        std::ptrdiff_t, T*, std::ptrdiff_t);                \
+  template void Gemm<T>(int, int, int, T, const T*, std::ptrdiff_t,         \
+                        std::ptrdiff_t, const T*, std::ptrdiff_t,           \
+                        std::ptrdiff_t, T, T*, std::ptrdiff_t);             \
+  template void Strassen<T>(int, const T*, std::ptrdiff_t, const T*,         \
+                            std::ptrdiff_t, T*, std::ptrdiff_t);            \
+  template int LuDecompose<T>(T*, int, int, int*, T);                       \
+  template void LuSolve<T>(const T*, int, int, const int*, const T*, int,   \
+                           T*, int, int);                                   \
+  template int LuDecomposeFull<T>(T*, int, int, int*, int*, T, int*);       \
+  template T SingularTolerance<T>(const T*, int, int, int);
+
+S21_INSTANTIATE_KERNELS(float)
+S21_INSTANTIATE_KERNELS(double)
+S21_INSTANTIATE_KERNELS(long double)
+
+#undef S21_INSTANTIATE_KERNELS
+
+}  // namespace s21_kernels
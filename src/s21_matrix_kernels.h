@@ -0,0 +1,116 @@
+#ifndef S21_MATRIX_KERNELS_H_
+#define S21_MATRIX_KERNELS_H_
+
+#include <cstddef>
+
+// Внутренние вычислительные ядра S21BasicMatrix. Матрицы передаются
+// указателем и парой шагов (между строками и между столбцами), поэтому
+// транспонированный операнд задаётся простой перестановкой шагов без
+// копирования.
+//
+// Векторные версии ядер для float и double выбираются один раз при первом
+// вызове по CPUID, так что одна сборка библиотеки использует лучший набор
+// инструкций на каждой машине. Переменная окружения S21_MATRIX_SIMD
+// (scalar, sse2, avx2, avx512) может понизить выбранный уровень. Для long
+// double всегда используются скалярные ядра.
+//
+// Шаблоны определены в s21_matrix_kernels.cc и инстанцированы для float,
+// double и long double.
+namespace s21_kernels {
+
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Уровень, на котором сейчас работают ядра.
+SimdLevel GetSimdLevel() noexcept;
+// Переключает ядра на level, но не выше поддерживаемого процессором;
+// возвращает фактически выбранный уровень.
+SimdLevel SetSimdLevel(SimdLevel level) noexcept;
+
+// Ниже этого числа умножений-сложений (m * n * k) блочное ядро не окупает
+// упаковку, и используется простой цикл i-k-j.
+constexpr std::ptrdiff_t kGemmSmallSize = 32 * 32 * 32;
+// Начиная с этого объёма плитки C распределяются по потокам S21ThreadPool.
+constexpr std::ptrdiff_t kGemmParallelSize = 128 * 128 * 128;
+
+// Квадратные произведения n x n при n >= crossover считаются по
+// Штрассену-Винограду (O(n^2.81)), листья рекурсии - обычным блочным Gemm.
+// 0 (по умолчанию) выключает этот путь; начальное значение можно задать
+// переменной окружения S21_MATRIX_STRASSEN. Выгода появляется от
+// нескольких тысяч; порог зависит от машины и числа потоков, его стоит
+// подбирать замером.
+//
+// Оценка ошибки нормовая, а не поэлементная (Higham, "Accuracy and
+// Stability of Numerical Algorithms", теорема 23.3): для листьев размера
+// n0 и машинной точности u
+//   max|C - C'| <= ((n / n0)^log2(18) * (n0^2 + 6 * n0) - 6 * n) * u *
+//                  max|A| * max|B|,
+// тогда как классическое произведение даёт |C - C'| <= n * u * |A| * |B|
+// поэлементно. Малые элементы C при больших элементах A и B могут потерять
+// все значащие цифры.
+int GetStrassenCrossover() noexcept;
+void SetStrassenCrossover(int n) noexcept;
+
+// Поэлементные операции над n подряд лежащими элементами.
+template <typename T>
+void Add(T* dst, const T* src, std::ptrdiff_t n) noexcept;
+template <typename T>
+void Sub(T* dst, const T* src, std::ptrdiff_t n) noexcept;
+template <typename T>
+void Scale(T* dst, T num, std::ptrdiff_t n) noexcept;
+// true, если |a[j] - b[j]| < eps для всех j.
+template <typename T>
+bool Near(const T* a, const T* b, std::ptrdiff_t n, T eps) noexcept;
+
+// dst (cols x rows, шаг строк ldd) = src^T (rows x cols, шаг lds).
+// Рекурсивное деление на блоки и векторные плитки 2x2 - 8x8.
+template <typename T>
+void Transpose(int rows, int cols, const T* src, std::ptrdiff_t lds, T* dst,
+               std::ptrdiff_t ldd) noexcept;
+// Транспонирует квадратную матрицу n x n на месте.
+template <typename T>
+void TransposeInPlace(int n, T* a, std::ptrdiff_t lda) noexcept;
+
+// C += alpha * A * B, где A - m x k, B - k x n, C - m x n (шаг строк ldc).
+// Большие произведения считаются параллельно в пуле потоков.
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, std::ptrdiff_t a_row,
+          std::ptrdiff_t a_col, const T* b, std::ptrdiff_t b_row,
+          std::ptrdiff_t b_col, T* c, std::ptrdiff_t ldc);
+// C = alpha * A * B + beta * C. Плитка C умножается на beta перед первым
+// накоплением в неё, в том же проходе; при beta == 0 прежние элементы C
+// (в том числе NaN) не читаются.
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, std::ptrdiff_t a_row,
+          std::ptrdiff_t a_col, const T* b, std::ptrdiff_t b_row,
+          std::ptrdiff_t b_col, T beta, T* c, std::ptrdiff_t ldc);
+
+// C (шаг строк ldc) = A * B для n x n по Штрассену-Винограду с листьями не
+// меньше max(GetStrassenCrossover(), 32). Строки A и B лежат подряд.
+template <typename T>
+void Strassen(int n, const T* a, std::ptrdiff_t lda, const T* b,
+              std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc);
+
+// LU-разложение квадратной матрицы n x n на месте с частичным выбором
+// ведущего элемента по столбцу: ниже диагонали L (без единичной
+// диагонали), на диагонали и выше - U, perm[i] - исходный номер i-й строки.
+// Возвращает знак перестановки или 0, если модуль ведущего элемента не
+// превышает tolerance.
+template <typename T>
+int LuDecompose(T* a, int n, int stride, int* perm, T tolerance = T(0));
+// Решает A * X = B по результату LuDecompose, B и X размера n x nrhs;
+// b == nullptr означает единичную правую часть.
+template <typename T>
+void LuSolve(const T* lu, int n, int lu_stride, const int* perm, const T* b,
+             int b_stride, T* x, int x_stride, int nrhs);
+// LU-разложение с полным выбором ведущего элемента: P * A * Q = L * U.
+// Возвращает найденный ранг, *sign - знак det(P) * det(Q).
+template <typename T>
+int LuDecomposeFull(T* a, int n, int stride, int* row_perm, int* col_perm,
+                    T tolerance, int* sign);
+// Порог вырожденности n * eps * max|a_ij| для ведущих элементов.
+template <typename T>
+T SingularTolerance(const T* a, int rows, int cols, int stride);
+
+}  // namespace s21_kernels
+
+#endif  // S21_MATRIX_KERNELS_H_
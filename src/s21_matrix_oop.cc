@@ -1,330 +1,847 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() : rows_(1), cols_(1) {
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+
+#include "s21_matrix_kernels.h"
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix() : rows_(1), cols_(1) {
   rows_ = 0;
   cols_ = 0;
   matrix_ = nullptr;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
-  Allocate();
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(std::pmr::memory_resource *resource)
+    : S21BasicMatrix() {
+  if (resource != nullptr) resource_ = resource;
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  this->Allocate();
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
+  Allocate();
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept {
-  matrix_ = other.matrix_;
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  other.matrix_ = nullptr;
-  other.cols_ = 0;
-  other.rows_ = 0;
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource *resource)
+    : rows_(rows), cols_(cols) {
+  if (resource != nullptr) resource_ = resource;
+  Allocate();
 }
 
-S21Matrix::~S21Matrix() { Deallocate(); }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols, S21Uninitialized,
+                                  std::pmr::memory_resource *resource)
+    : rows_(rows), cols_(cols) {
+  if (resource != nullptr) resource_ = resource;
+  Allocate(false);
+}
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
-  bool res = true;
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    res = false;
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrixView<T> &view,
+                                  std::pmr::memory_resource *resource)
+    : rows_(view.GetRows()), cols_(view.GetCols()) {
+  if (resource != nullptr) resource_ = resource;
+  Allocate(false);
+  if (view.IsRowMajor()) {
+    for (int i = 0; i < rows_; ++i) {
+      std::copy(view.Row(i), view.Row(i) + cols_, Row(i));
+    }
+  } else if (view.GetStride() == 1) {
+    // Буфер по столбцам - это транспонированная матрица по строкам.
+    s21_kernels::Transpose(cols_, rows_, view.Data(), view.GetColStride(),
+                           matrix_, stride_);
   } else {
     for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        if (std::fabs(matrix_[i][j] - other.matrix_[i][j]) >= 1e-7) {
-          res = false;
-        }
-      }
+      for (int j = 0; j < cols_; ++j) Row(i)[j] = view.At(i, j);
     }
   }
-  return res;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(other.rows_), cols_(other.cols_), resource_(other.resource_) {
+  Allocate(false);
+  CopyElements(other);
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept {
+  MoveFrom(other);
+}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { Deallocate(); }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Wrap(T *data, int rows, int cols,
+                                          int stride) {
+  return Adopt(data, rows, cols, nullptr, stride);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Adopt(T *data, int rows, int cols,
+                                           std::function<void(T *)> deleter,
+                                           int stride) {
+  if (stride == 0) stride = cols;
+  if (data == nullptr || rows < 1 || cols < 1 || stride < cols) {
+    throw std::invalid_argument("Invalid external buffer");
+  }
+  S21BasicMatrix result;
+  result.matrix_ = data;
+  result.rows_ = rows;
+  result.cols_ = cols;
+  result.stride_ = stride;
+  result.capacity_ = static_cast<std::size_t>(rows) * stride;
+  result.external_ = true;
+  result.deleter_ = std::move(deleter);
+  return result;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const {
+  return View().EqMatrix(other.View());
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrixView<T> &other) const {
+  return View().EqMatrix(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
   if (EqualSizeMatrix(other)) {
     for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] += other.matrix_[i][j];
-      }
+      s21_kernels::Add(Row(i), other.Row(i), cols_);
     }
   }
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
   if (EqualSizeMatrix(other)) {
     for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] -= other.matrix_[i][j];
-      }
+      s21_kernels::Sub(Row(i), other.Row(i), cols_);
     }
   }
 }
 
-void S21Matrix::MulNumber(double num) noexcept {
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(T num) noexcept {
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
+    s21_kernels::Scale(Row(i), num, cols_);
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-  if (EqualColsRowsOfTwoMatrix(other)) {
-    S21Matrix res(rows_, other.cols_);
-    for (int i = 0; i < res.rows_; ++i) {
-      for (int j = 0; j < res.cols_; ++j) {
-        for (int k = 0; k < cols_; ++k) {
-          res.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-        }
-      }
-    }
-    *this = std::move(res);
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other) {
+  MulMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T> &other) {
+  if (cols_ == other.GetRows()) {
+    *this = View().MultiplyWith(other, resource_);
   }
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result.matrix_[j][i] = matrix_[i][j];
+template <typename T>
+void S21BasicMatrix<T>::MulAdd(T alpha, const S21BasicMatrixView<T> &a,
+                               const S21BasicMatrixView<T> &b, T beta,
+                               S21Transpose op_a, S21Transpose op_b) {
+  auto op = [](S21BasicMatrixView<T> x, S21Transpose transpose) {
+    if (transpose == S21Transpose::kTranspose) {
+      std::swap(x.rows_, x.cols_);
+      std::swap(x.stride_, x.col_stride_);
     }
+    return x;
+  };
+  S21BasicMatrixView<T> x = op(a, op_a);
+  S21BasicMatrixView<T> y = op(b, op_b);
+  if (x.rows_ != rows_ || y.cols_ != cols_ || x.cols_ != y.rows_) {
+    throw std::invalid_argument("Matrix sizes do not match");
   }
-  return result;
+  // Множитель, лежащий в самой матрице, копируется: Gemm перезаписывает C,
+  // пока ещё читает A и B.
+  const T *begin = matrix_;
+  const T *end = matrix_ + static_cast<std::ptrdiff_t>(rows_) * stride_;
+  auto overlaps = [&](const S21BasicMatrixView<T> &v) {
+    if (v.rows_ == 0 || v.cols_ == 0) return false;
+    const T *last = v.data_ +
+                    static_cast<std::ptrdiff_t>(v.rows_ - 1) * v.stride_ +
+                    static_cast<std::ptrdiff_t>(v.cols_ - 1) * v.col_stride_;
+    return std::less<const T *>()(v.data_, end) &&
+           !std::less<const T *>()(last, begin);
+  };
+  S21BasicMatrix x_copy(resource_);
+  S21BasicMatrix y_copy(resource_);
+  if (overlaps(x)) {
+    x_copy = S21BasicMatrix(x, resource_);
+    x = x_copy.View();
+  }
+  if (overlaps(y)) {
+    y_copy = S21BasicMatrix(y, resource_);
+    y = y_copy.View();
+  }
+  s21_kernels::Gemm(rows_, cols_, x.cols_, alpha, x.data_, x.stride_,
+                    x.col_stride_, y.data_, y.stride_, y.col_stride_, beta,
+                    matrix_, stride_);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  return View().TransposeWith(resource_);
 }
 
-S21Matrix S21Matrix::CalcComplements() {
-  S21Matrix result(rows_, cols_);
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
   if (SquareMatrix()) {
+    s21_kernels::TransposeInPlace(rows_, matrix_, stride_);
+  } else {
+    *this = Transpose();
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
+  S21BasicMatrix result(rows_, cols_, resource_);
+  if (SquareMatrix() && rows_ == 1) {
+    // Минор 1x1 - пустая матрица с определителем 1, как у S21FixedMatrix.
+    result.matrix_[0] = T(1);
+  } else if (SquareMatrix() && rows_ > 3) {
+    ComplementsByLu(result);
+  } else if (SquareMatrix()) {
     for (int i = 0; i < rows_; ++i) {
       for (int j = 0; j != cols_; ++j) {
-        S21Matrix minor_matrix = Minor(i, j);
-        result.matrix_[i][j] =
-            std::pow((-1), i + j) * minor_matrix.Determinant();
+        S21BasicMatrix minor_matrix = Minor(i, j);
+        result.Row(i)[j] = std::pow((-1), i + j) * minor_matrix.Determinant();
       }
     }
   }
   return result;
 }
 
-double S21Matrix::Determinant() {
-  double result = 0.0;
-  if (SquareMatrix()) {
-    if (rows_ == 1) {
-      result = matrix_[0][0];
-    } else if (rows_ == 2) {
-      result = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
-    } else {
-      for (int j = 0; j < cols_; ++j) {
-        S21Matrix minor_matrix = Minor(0, j);
-        result += matrix_[0][j] * pow(-1, j) * minor_matrix.Determinant();
-      }
+// Матрица алгебраических дополнений - это транспонированная
+// присоединённая: C = adj(A)^T. Для невырожденной A adj(A) = det(A) * A^-1,
+// то есть C = det(A) * (A^-1)^T, и хватает одного LU-разложения.
+//
+// Вырожденная A раскладывается с полным выбором: P * A * Q = L * U. При
+// ранге меньше n - 1 все миноры порядка n - 1 нулевые, и C = 0. При ранге
+// n - 1 у U = [U1 b; 0 d] невырожден блок U1, и
+//   adj(U) = det(U1) * [d * U1^-1, -U1^-1 * b; 0, 1],
+//   adj(A) = det(P) * det(Q) * Q * adj(U) * L^-1 * P.
+// Всё это O(n^3) и не требует обращения вырожденной матрицы.
+template <typename T>
+void S21BasicMatrix<T>::ComplementsByLu(S21BasicMatrix &result) const {
+  const int n = rows_;
+  S21BasicMatrix lu(*this);
+  // Перестановки малой матрицы помещаются в стек.
+  int local_perm[2 * kInlineCapacity];
+  std::pmr::monotonic_buffer_resource scratch(local_perm, sizeof(local_perm),
+                                              resource_);
+  std::pmr::vector<int> row_perm(n, &scratch);
+  const T tolerance =
+      s21_kernels::SingularTolerance(matrix_, rows_, cols_, stride_);
+  int sign = s21_kernels::LuDecompose(lu.matrix_, n, lu.stride_,
+                                      row_perm.data(), tolerance);
+  if (sign != 0) {
+    T det = sign;
+    for (int i = 0; i < n; ++i) det *= lu.Row(i)[i];
+    S21BasicMatrix inverse(n, n, kS21Uninitialized, resource_);
+    s21_kernels::LuSolve<T>(lu.matrix_, n, lu.stride_, row_perm.data(),
+                            nullptr, 0, inverse.matrix_, inverse.stride_, n);
+    s21_kernels::Transpose(n, n, inverse.matrix_, inverse.stride_,
+                           result.matrix_, result.stride_);
+    result.MulNumber(det);
+    return;
+  }
+
+  lu = *this;
+  std::pmr::vector<int> col_perm(n, &scratch);
+  const int rank =
+      s21_kernels::LuDecomposeFull(lu.matrix_, n, lu.stride_, row_perm.data(),
+                                   col_perm.data(), tolerance, &sign);
+  if (rank < n - 1) return;  // result уже нулевая.
+
+  // w = adj(U) / det(U1); сначала U1^-1 обратной подстановкой по столбцам
+  // единичной матрицы, затем последний столбец -U1^-1 * b.
+  const int m = n - 1;
+  S21BasicMatrix w(n, n, resource_);
+  for (int i = m - 1; i >= 0; --i) {
+    const T *u_i = lu.Row(i);
+    T *w_i = w.Row(i);
+    w_i[i] = T(1);
+    for (int k = i + 1; k < m; ++k) {
+      const T factor = u_i[k];
+      const T *w_k = w.Row(k);
+      for (int j = k; j < n; ++j) w_i[j] -= factor * w_k[j];
     }
+    // Последний столбец решает U1 * z = -b.
+    w_i[m] -= u_i[m];
+    const T inv = T(1) / u_i[i];
+    for (int j = i; j < n; ++j) w_i[j] *= inv;
   }
-  return result;
+  const T d = lu.Row(m)[m];
+  for (int i = 0; i < m; ++i) {
+    T *w_i = w.Row(i);
+    for (int j = i; j < m; ++j) w_i[j] *= d;
+  }
+  w.Row(m)[m] = T(1);
+
+  // y = w * L^-1: каждая строка решает y * L = w_i справа налево.
+  for (int i = 0; i < n; ++i) {
+    T *y_i = w.Row(i);
+    for (int j = n - 1; j >= 0; --j) {
+      T sum = y_i[j];
+      for (int k = j + 1; k < n; ++k) sum -= y_i[k] * lu.Row(k)[j];
+      y_i[j] = sum;
+    }
+  }
+
+  T scale = sign;
+  for (int i = 0; i < m; ++i) scale *= lu.Row(i)[i];
+  for (int j = 0; j < n; ++j) {
+    const T *y_j = w.Row(j);
+    for (int i = 0; i < n; ++i) {
+      result.Row(row_perm[i])[col_perm[j]] = scale * y_j[i];
+    }
+  }
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
+  return View().DeterminantWith(resource_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const noexcept {
+  S21BasicMatrixView<T> view;
+  view.data_ = matrix_;
+  view.rows_ = rows_;
+  view.cols_ = cols_;
+  view.stride_ = stride_;
+  return view;
 }
 
-S21Matrix S21Matrix::Minor(int row, int col) {
-  S21Matrix result(rows_ - 1, cols_ - 1);
-  for (int i = 0, min_i = 0; min_i < result.rows_; ++min_i) {
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Minor(int row, int col) {
+  S21BasicMatrix result(rows_ - 1, cols_ - 1, kS21Uninitialized, resource_);
+  for (int i = 0, min_i = 0; min_i < result.rows_; ++min_i, ++i) {
     if (row == i) ++i;
-    for (int j = 0, min_j = 0; min_j < result.cols_; ++min_j) {
-      if (col == j) ++j;
-      result.matrix_[min_i][min_j] = matrix_[i][j];
-      ++j;
-    }
-    ++i;
+    const T *src = Row(i);
+    T *dst = result.Row(min_i);
+    std::copy(src, src + col, dst);
+    std::copy(src + col + 1, src + cols_, dst + col);
   }
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  double det = Determinant();
-  if (std::fabs(det) < 1e-7) {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  // Одно LU-разложение служит и проверкой на вырожденность, и основой для
+  // решения A * X = I прямо в буфер результата.
+  S21BasicMatrix lu(resource_);
+  int local_perm[kInlineCapacity];
+  std::pmr::monotonic_buffer_resource scratch(local_perm, sizeof(local_perm),
+                                              resource_);
+  std::pmr::vector<int> perm(rows_, &scratch);
+  int sign = 0;
+  if (SquareMatrix()) {
+    lu = *this;
+    sign = s21_kernels::LuDecompose(
+        lu.matrix_, rows_, lu.stride_, perm.data(),
+        s21_kernels::SingularTolerance(matrix_, rows_, cols_, stride_));
+  }
+  if (sign == 0) {
     throw std::invalid_argument("Matrix determinant must be > 0.");
   }
-  S21Matrix result(rows_, cols_);
-  if (rows_ == 1) {
-    result(0, 0) = 1 / matrix_[0][0];
+  S21BasicMatrix result(rows_, cols_, kS21Uninitialized, resource_);
+  if (rows_ <= 3) {
+    // До 3x3 присоединённая матрица в явном виде точнее подстановок.
+    // Определитель - разложение по первой строке из тех же дополнений.
+    auto at = [this](int i, int j) { return Row(i % rows_)[j % rows_]; };
+    T complements[3][3] = {{T(1)}};
+    if (rows_ == 2) {
+      complements[0][0] = at(1, 1);
+      complements[0][1] = -at(1, 0);
+      complements[1][0] = -at(0, 1);
+      complements[1][1] = at(0, 0);
+    } else if (rows_ == 3) {
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          complements[i][j] = at(i + 1, j + 1) * at(i + 2, j + 2) -
+                              at(i + 1, j + 2) * at(i + 2, j + 1);
+        }
+      }
+    }
+    T det = 0;
+    for (int j = 0; j < rows_; ++j) det += at(0, j) * complements[0][j];
+    const T inverse_det = 1 / det;
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < rows_; ++j) {
+        result.Row(j)[i] = complements[i][j] * inverse_det;
+      }
+    }
   } else {
-    S21Matrix temp = CalcComplements();
-    result = temp.Transpose();
-    result.MulNumber(1 / det);
+    s21_kernels::LuSolve<T>(lu.matrix_, rows_, lu.stride_, perm.data(),
+                            nullptr, 0, result.matrix_, result.stride_, cols_);
   }
   return result;
 }
 
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrix &b) {
+  return Solve(b.View());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrixView<T> &b) {
+  if (b.GetRows() != rows_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (!b.IsRowMajor()) return Solve(S21BasicMatrix(b, resource_));
+  S21BasicMatrix lu(resource_);
+  int local_perm[kInlineCapacity];
+  std::pmr::monotonic_buffer_resource scratch(local_perm, sizeof(local_perm),
+                                              resource_);
+  std::pmr::vector<int> perm(rows_, &scratch);
+  int sign = 0;
+  if (SquareMatrix()) {
+    lu = *this;
+    sign = s21_kernels::LuDecompose(
+        lu.matrix_, rows_, lu.stride_, perm.data(),
+        s21_kernels::SingularTolerance(matrix_, rows_, cols_, stride_));
+  }
+  if (sign == 0) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  S21BasicMatrix result(rows_, b.GetCols(), kS21Uninitialized, resource_);
+  s21_kernels::LuSolve(lu.matrix_, rows_, lu.stride_, perm.data(), b.Data(),
+                       b.GetStride(), result.matrix_, result.stride_,
+                       result.cols_);
+  return result;
+}
+
 // Операторы :
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
-  if (this != &other) {
-    Deallocate();
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
+  if (this == &other) return *this;
+  if (other.rows_ <= GetRowCapacity() && other.cols_ <= GetColCapacity()) {
+    // Копия помещается в текущий буфер - память не выделяется.
     rows_ = other.rows_;
     cols_ = other.cols_;
-    this->Allocate();
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
+    CopyElements(other);
+  } else {
+    // Новый буфер готовится до освобождения старого: если выделение
+    // бросит исключение, матрица останется прежней.
+    S21BasicMatrix copy(other.rows_, other.cols_, kS21Uninitialized,
+                        resource_);
+    copy.CopyElements(other);
+    *this = std::move(copy);
   }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) noexcept {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    S21BasicMatrix &&other) noexcept {
   if (this != &other) {
     Deallocate();
-    std::swap(rows_, other.rows_);
-    std::swap(cols_, other.cols_);
-    std::swap(matrix_, other.matrix_);
+    MoveFrom(other);
   }
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) const {
   return EqMatrix(other);
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  S21Matrix resultMatrix(*this);
-  resultMatrix.SumMatrix(other);
-  return resultMatrix;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  S21Matrix resultMatrix(*this);
-  resultMatrix.SubMatrix(other);
-  return resultMatrix;
-}
-
-S21Matrix S21Matrix::operator*(double num) const noexcept {
-  S21Matrix resultMatrix(*this);
-  resultMatrix.MulNumber(num);
-  return resultMatrix;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const S21BasicMatrix &other) {
+  // Как и MulMatrix, при несовпадении размеров результат равен *this.
+  if (cols_ != other.rows_) return *this;
+  return View().MultiplyWith(other.View(), resource_);
 }
 
-S21Matrix operator*(const double num, const S21Matrix &other) noexcept {
-  return other * num;
-}
-
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  S21Matrix resultMatrix(*this);
-  resultMatrix.MulMatrix(other);
-  return resultMatrix;
-}
-
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(double num) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(T num) {
   MulNumber(num);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &other) {
   MulMatrix(other);
   return *this;
 }
 
-double &S21Matrix::operator()(int i, int j) {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int i, int j) {
   if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
     throw std::out_of_range("Index is out of the matrix range");
   }
-  return matrix_[i][j];
+  return Row(i)[j];
 }
 
-double S21Matrix::operator()(int i, int j) const {
+template <typename T>
+T S21BasicMatrix<T>::operator()(int i, int j) const {
   if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
     throw std::out_of_range("Index is out of the matrix range");
   }
-  return matrix_[i][j];
+  return Row(i)[j];
 }
 
 // Доп. функции:
 
-int S21Matrix::GetRows() const noexcept { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const noexcept { return rows_; }
 
-int S21Matrix::GetCols() const noexcept { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const noexcept { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
-  double **newMatrix;
-  AlocMatrix(&newMatrix, rows, cols_);
-  for (int i = 0; i < rows && i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      newMatrix[i][j] = (*this)(i, j);
-    }
+template <typename T>
+std::pmr::memory_resource *S21BasicMatrix<T>::GetResource() const noexcept {
+  return resource_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
+  if (rows < 0) {
+    throw std::invalid_argument("Invalid number of rows " +
+                                std::to_string(rows));
+  }
+  const int capacity = GetRowCapacity();
+  if (rows > capacity) {
+    // Запас по столбцам при переносе не сохраняется.
+    Reallocate(static_cast<int>(std::min<long long>(
+                   std::max<long long>(rows, 2LL * capacity),
+                   std::numeric_limits<int>::max())),
+               cols_);
+  }
+  // Строки, оставшиеся от прежнего уменьшения, обнуляются.
+  for (int i = rows_; i < rows; ++i) {
+    std::fill(Row(i), Row(i) + cols_, T(0));
   }
-  DelMatrix(matrix_);
   rows_ = rows;
-  matrix_ = newMatrix;
 }
 
-void S21Matrix::SetCols(int cols) {
-  double **newMatrix;
-  AlocMatrix(&newMatrix, rows_, cols);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols && j < cols_; j++) {
-      newMatrix[i][j] = (*this)(i, j);
-    }
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
+  if (cols < 0) {
+    throw std::invalid_argument("Invalid number of cols " +
+                                std::to_string(cols));
+  }
+  const int capacity = GetColCapacity();
+  if (cols > capacity) {
+    Reallocate(rows_, static_cast<int>(std::min<long long>(
+                          std::max<long long>(cols, 2LL * capacity),
+                          std::numeric_limits<int>::max())));
+  }
+  for (int i = 0; i < rows_; ++i) {
+    std::fill(Row(i) + cols_, Row(i) + std::max(cols, cols_), T(0));
   }
-  DelMatrix(matrix_);
   cols_ = cols;
-  matrix_ = newMatrix;
 }
 
-void S21Matrix::AlocMatrix(double ***matrix, int rows, int cols) {
-  // if (rows == 1 && cols == 1) {
-  //   throw std::invalid_argument("Invalid number of rows " +
-  //                               std::to_string(rows));
-  // }
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Invalid capacity " + std::to_string(rows) +
+                                "x" + std::to_string(cols));
+  }
+  if (cols > GetColCapacity()) {
+    Reallocate(std::max(rows, rows_), cols);
+  } else if (rows > GetRowCapacity()) {
+    Reallocate(rows, stride_);
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() {
+  if (matrix_ != nullptr && !IsInline() &&
+      capacity_ != static_cast<std::size_t>(rows_) * cols_) {
+    Reallocate(rows_, cols_);
+  }
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRowCapacity() const noexcept {
+  // Строк нулевой ширины помещается сколько угодно.
+  std::size_t rows = std::numeric_limits<int>::max();
+  if (stride_ > 0) rows = std::min(rows, capacity_ / stride_);
+  return static_cast<int>(rows);
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetColCapacity() const noexcept {
+  // Столбцы чужого буфера (Wrap) за последним принадлежат вызывающему:
+  // расширение переносит матрицу в собственную память.
+  return external_ && !deleter_ ? cols_ : stride_;
+}
+
+template <typename T>
+T *S21BasicMatrix<T>::AlocMatrix(int rows, int cols, bool zero_fill) {
   if (rows < 0 || cols < 0) {
     throw std::invalid_argument("Invalid number of cols " +
                                 std::to_string(cols));
   }
-  *matrix = new double *[rows]();
-  for (int i = 0; i < rows; i++) {
-    (*matrix)[i] = new double[cols]();
+  std::size_t count =
+      static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols);
+  T *matrix = count <= kInlineCapacity
+                  ? inline_
+                  : static_cast<T *>(
+                        resource_->allocate(sizeof(T) * count, kAlignment));
+  if (zero_fill) {
+    std::fill(matrix, matrix + BufferCapacity(rows, cols), T(0));
   }
+  return matrix;
 }
 
-void S21Matrix::Allocate() {
+template <typename T>
+void S21BasicMatrix<T>::Allocate(bool zero_fill) {
   if (rows_ < 1 || cols_ < 1) {
     throw std::invalid_argument("Matrix size cannot be less than 1x1");
   }
-  matrix_ = new double *[rows_]();
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_]();
-  }
+  matrix_ = AlocMatrix(rows_, cols_, zero_fill);
+  capacity_ = BufferCapacity(rows_, cols_);
+  stride_ = cols_;
 }
 
-void S21Matrix::Deallocate() {
+template <typename T>
+void S21BasicMatrix<T>::Deallocate() {
   if (matrix_ != nullptr) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+    DelMatrix(matrix_, capacity_);
     matrix_ = nullptr;
     rows_ = 0;
     cols_ = 0;
+    stride_ = 0;
+    capacity_ = 0;
   }
 }
 
-void S21Matrix::DelMatrix(double **matrix) {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix[i];
+template <typename T>
+void S21BasicMatrix<T>::DelMatrix(T *matrix, std::size_t count) {
+  if (external_) {
+    if (deleter_) deleter_(matrix);
+    deleter_ = nullptr;
+    external_ = false;
+  } else if (matrix != nullptr && matrix != inline_) {
+    resource_->deallocate(matrix, sizeof(T) * count, kAlignment);
   }
-  delete[] matrix;
 }
+
+template <typename T>
+void S21BasicMatrix<T>::CopyElements(const S21BasicMatrix &other) {
+  if (stride_ == other.stride_) {
+    std::memcpy(matrix_, other.matrix_,
+                sizeof(T) * static_cast<std::size_t>(rows_) * stride_);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      std::memcpy(Row(i), other.Row(i), sizeof(T) * cols_);
+    }
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MoveFrom(S21BasicMatrix &other) noexcept {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  capacity_ = other.capacity_;
+  resource_ = other.resource_;
+  if (other.IsInline()) {
+    // Часть встроенного буфера может быть не инициализирована.
+    std::memcpy(inline_, other.inline_, sizeof(inline_));
+    matrix_ = inline_;
+  } else {
+    matrix_ = other.matrix_;
+  }
+  external_ = other.external_;
+  deleter_.swap(other.deleter_);
+  other.external_ = false;
+  other.matrix_ = nullptr;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.capacity_ = 0;
+}
+
+// Переносит элементы в новый буфер со stride и местом под row_capacity
+// строк. Новый буфер заполняется в отдельном объекте, поэтому старые и
+// новые элементы не пересекаются, даже если оба помещаются во встроенный
+// буфер.
+template <typename T>
+void S21BasicMatrix<T>::Reallocate(int row_capacity, int stride) {
+  S21BasicMatrix moved(resource_);
+  // SetRows/SetCols сами обнуляют открывающиеся строки и столбцы.
+  moved.matrix_ = moved.AlocMatrix(row_capacity, stride, false);
+  moved.capacity_ = moved.BufferCapacity(row_capacity, stride);
+  moved.rows_ = rows_;
+  moved.cols_ = cols_;
+  moved.stride_ = stride;
+  for (int i = 0; i < rows_; ++i) {
+    std::copy(Row(i), Row(i) + cols_, moved.Row(i));
+  }
+  *this = std::move(moved);
+}
+
+template <typename T>
+std::size_t S21BasicMatrix<T>::BufferCapacity(int rows,
+                                              int cols) const noexcept {
+  std::size_t count =
+      static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols);
+  return count <= kInlineCapacity ? kInlineCapacity : count;
+}
+
+// Представление:
+
+template <typename T>
+bool S21BasicMatrixView<T>::EqMatrix(const S21BasicMatrixView &other) const {
+  bool res = rows_ == other.rows_ && cols_ == other.cols_;
+  if (IsRowMajor() && other.IsRowMajor()) {
+    for (int i = 0; i < rows_ && res; ++i) {
+      res = s21_kernels::Near(Row(i), other.Row(i), cols_,
+                              S21MatrixTolerance<T>::kEqual);
+    }
+  } else {
+    for (int i = 0; i < rows_ && res; ++i) {
+      for (int j = 0; j < cols_ && res; ++j) {
+        res = std::fabs(At(i, j) - other.At(i, j)) <
+              S21MatrixTolerance<T>::kEqual;
+      }
+    }
+  }
+  return res;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::Determinant() const {
+  return DeterminantWith(std::pmr::get_default_resource());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::Transpose() const {
+  return TransposeWith(std::pmr::get_default_resource());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::Multiply(
+    const S21BasicMatrixView &other) const {
+  S21BasicMatrix<T> result;
+  if (cols_ == other.rows_) {
+    result = MultiplyWith(other, std::pmr::get_default_resource());
+  } else {
+    result = S21BasicMatrix<T>(*this);
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::DeterminantWith(
+    std::pmr::memory_resource *resource) const {
+  T result = T(0);
+  if (rows_ == cols_) {
+    if (rows_ == 1) {
+      result = data_[0];
+    } else if (rows_ == 2) {
+      result = At(0, 0) * At(1, 1) - At(0, 1) * At(1, 0);
+    } else if (rows_ == 3) {
+      result = At(0, 0) * (At(1, 1) * At(2, 2) - At(1, 2) * At(2, 1)) -
+               At(0, 1) * (At(1, 0) * At(2, 2) - At(1, 2) * At(2, 0)) +
+               At(0, 2) * (At(1, 0) * At(2, 1) - At(1, 1) * At(2, 0));
+    } else if (rows_ > 3) {
+      // O(n^3) через LU-разложение копии вместо разложения по строке.
+      S21BasicMatrix<T> lu(*this, resource);
+      // Перестановка малой матрицы помещается в стек.
+      int local_perm[S21BasicMatrix<T>::kInlineCapacity];
+      std::pmr::monotonic_buffer_resource scratch(
+          local_perm, sizeof(local_perm), resource);
+      std::pmr::vector<int> perm(rows_, &scratch);
+      int sign =
+          s21_kernels::LuDecompose(lu.matrix_, rows_, lu.stride_, perm.data());
+      if (sign != 0) {
+        result = sign;
+        for (int i = 0; i < rows_; ++i) {
+          result *= lu.Row(i)[i];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::TransposeWith(
+    std::pmr::memory_resource *resource) const {
+  S21BasicMatrix<T> result(cols_, rows_, kS21Uninitialized, resource);
+  if (IsRowMajor()) {
+    s21_kernels::Transpose(rows_, cols_, data_, stride_, result.matrix_,
+                           result.stride_);
+  } else if (stride_ == 1) {
+    // Столбец буфера по столбцам - готовая строка результата.
+    for (int j = 0; j < cols_; ++j) {
+      const T *column = data_ + static_cast<std::ptrdiff_t>(j) * col_stride_;
+      std::copy(column, column + rows_, result.Row(j));
+    }
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        result.Row(j)[i] = At(i, j);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::MultiplyWith(
+    const S21BasicMatrixView &other,
+    std::pmr::memory_resource *resource) const {
+  const int crossover = s21_kernels::GetStrassenCrossover();
+  if (crossover > 0 && rows_ >= crossover && rows_ == cols_ &&
+      rows_ == other.cols_ && IsRowMajor() && other.IsRowMajor()) {
+    S21BasicMatrix<T> result(rows_, rows_, kS21Uninitialized, resource);
+    s21_kernels::Strassen(rows_, data_, stride_, other.data_, other.stride_,
+                          result.matrix_, result.stride_);
+    return result;
+  }
+  // beta == 0: Gemm не читает C, обнулять результат не нужно.
+  S21BasicMatrix<T> result(rows_, other.cols_, kS21Uninitialized, resource);
+  s21_kernels::Gemm(rows_, other.cols_, cols_, T(1), data_, stride_,
+                    col_stride_, other.data_, other.stride_,
+                    other.col_stride_, T(0), result.matrix_, result.stride_);
+  return result;
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
@@ -2,81 +2,259 @@
 #define S21_MATRIX_OOP_H_
 
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <memory_resource>
 #include <stdexcept>
 
-class S21Matrix {
+#include "s21_matrix_view.h"
+
+template <typename E>
+class S21MatrixExpr;
+template <typename T>
+class S21BasicLU;
+template <typename T>
+class S21BasicCholesky;
+template <typename T>
+class S21BasicQR;
+template <typename T>
+class S21BasicSparseMatrix;
+template <typename T>
+class S21BasicBandMatrix;
+template <typename T>
+class S21BasicTriangularMatrix;
+template <typename T>
+class S21BasicSymmetricMatrix;
+
+// Допуск сравнения элементов в EqMatrix для каждого типа элементов.
+template <typename T>
+struct S21MatrixTolerance;
+
+template <>
+struct S21MatrixTolerance<float> {
+  static constexpr float kEqual = 1e-4f;
+};
+
+template <>
+struct S21MatrixTolerance<double> {
+  static constexpr double kEqual = 1e-7;
+};
+
+template <>
+struct S21MatrixTolerance<long double> {
+  static constexpr long double kEqual = 1e-10L;
+};
+
+// Тег конструктора, который не обнуляет элементы:
+// S21Matrix m(rows, cols, kS21Uninitialized). Значения элементов не
+// определены, пока их не записали.
+struct S21Uninitialized {
+  explicit S21Uninitialized() = default;
+};
+inline constexpr S21Uninitialized kS21Uninitialized{};
+
+// Матрица с элементами типа T (float, double или long double). Методы
+// определены в s21_matrix_oop.cc и инстанцированы для этих трёх типов.
+//
+// Буфер элементов выделяется из std::pmr::memory_resource, переданного в
+// конструктор (по умолчанию - std::pmr::get_default_resource()). Копии и
+// результаты операций (Transpose, MulMatrix, InverseMatrix и т.д.)
+// берут память из ресурса исходной матрицы, поэтому серию вычислений можно
+// целиком разместить в арене или пуле. Перемещение передаёт буфер вместе
+// с ресурсом. Ресурс должен жить дольше всех матриц, использующих его.
+// Так же устроены остальные типы библиотеки: разложения, разреженные,
+// структурированные матрицы и пакеты.
+//
+// Рабочие буферы ядер в ресурс не входят: упаковка Gemm (thread_local,
+// около 4 МБ на поток для double), временные матрицы Strassen и пакетных
+// операций. Их заполняют потоки S21ThreadPool, а ресурс (например,
+// арена) не обязан быть потокобезопасным.
+//
+// Матрицы до kInlineCapacity элементов (например, 2x2 - 4x4) хранят
+// элементы прямо в объекте и не обращаются к ресурсу вовсе.
+template <typename T>
+class S21BasicMatrix {
  public:
+  using value_type = T;
+
+  static constexpr int kInlineCapacity = 16;
+
   //// Конструкторы и деструктор:
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix();
+  S21BasicMatrix();
+  explicit S21BasicMatrix(std::pmr::memory_resource* resource);
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(int rows, int cols, std::pmr::memory_resource* resource);
+  // Без обнуления: для матриц, которые сразу целиком перезаписываются.
+  S21BasicMatrix(int rows, int cols, S21Uninitialized,
+                 std::pmr::memory_resource* resource = nullptr);
+  // Копирует элементы представления; nullptr - ресурс по умолчанию.
+  explicit S21BasicMatrix(const S21BasicMatrixView<T>& view,
+                          std::pmr::memory_resource* resource = nullptr);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  // Вычисляет выражение a + b - c * 2.0 и т.п. одним проходом.
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
+  ~S21BasicMatrix();
+  // Матрица поверх внешнего буфера row-major из rows * stride элементов
+  // (stride == 0 - то же, что cols) без копирования и обнуления. Wrap не
+  // владеет буфером, и буфер должен пережить матрицу. Adopt забирает
+  // владение и освобождает буфер вызовом deleter(data); при исключении
+  // владение остаётся у вызывающего. Если размеры выходят за пределы
+  // буфера (у Wrap - за rows x cols: хвосты строк до stride остаются
+  // вызывающему), элементы переносятся в собственную память, а внешний
+  // буфер отпускается. Буфер по столбцам описывает S21BasicMatrixView.
+  static S21BasicMatrix Wrap(T* data, int rows, int cols, int stride = 0);
+  static S21BasicMatrix Adopt(T* data, int rows, int cols,
+                              std::function<void(T*)> deleter,
+                              int stride = 0);
   void Memory() {
-    matrix_ = new double*[rows_];
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_];
-    }
+    matrix_ = AlocMatrix(rows_, cols_);
+    capacity_ = BufferCapacity(rows_, cols_);
+    stride_ = cols_;
   }
   // Операции над матрицами:
-  bool EqMatrix(const S21Matrix& other) const;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(double num) noexcept;
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  bool EqMatrix(const S21BasicMatrixView<T>& other) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(T num) noexcept;
+  // Квадратные произведения от s21_kernels::GetStrassenCrossover() и выше
+  // считаются по Штрассену-Винограду (по умолчанию выключено).
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const S21BasicMatrixView<T>& other);
+  // this = alpha * op(A) * op(B) + beta * this, где op(X) - X или X^T:
+  // транспонирование - только обмен шагов, копия не создаётся. Считается
+  // одним проходом s21_kernels::Gemm без временных матриц; при beta == 0
+  // прежние элементы не читаются. Несогласованные размеры -
+  // std::invalid_argument.
+  void MulAdd(T alpha, const S21BasicMatrixView<T>& a,
+              const S21BasicMatrixView<T>& b, T beta,
+              S21Transpose op_a = S21Transpose::kNone,
+              S21Transpose op_b = S21Transpose::kNone);
+  S21BasicMatrix Transpose();
+  // Квадратная матрица транспонируется на месте без выделения памяти,
+  // прямоугольная - через Transpose().
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  T Determinant();
+  S21BasicMatrix InverseMatrix();
+  // X из this * X = B без обращения матрицы: одно LU-разложение и
+  // подстановки сразу для всех столбцов B. Для вырожденной матрицы бросает
+  // то же исключение, что и InverseMatrix(). Для многократного решения с
+  // одной матрицей см. S21BasicLU в s21_matrix_decomposition.h.
+  S21BasicMatrix Solve(const S21BasicMatrix& b);
+  S21BasicMatrix Solve(const S21BasicMatrixView<T>& b);
 
   // Операторы :
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other) noexcept;
-  bool operator==(const S21Matrix& other) const;
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(double num) const noexcept;
-  // Предусмотрен случай, где число умножается на матрицу: num * matrix
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(double num);
-  S21Matrix& operator*=(const S21Matrix& other);
-  double& operator()(int i, int j);
-  double operator()(int i, int j) const;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  bool operator==(const S21BasicMatrix& other) const;
+  // operator+, operator- и operator*(число) возвращают ленивые выражения,
+  // см. s21_matrix_expr.h.
+  S21BasicMatrix operator*(const S21BasicMatrix& other);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(T num);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
 
   // Доп. функции:
   void PrintMatrix();
-  void FillMatrix(double value);
+  void FillMatrix(T value);
   int GetRows() const noexcept;
   int GetCols() const noexcept;
   void SetRows(int rows);
   void SetCols(int cols);
+  // Ёмкость буфера: SetRows/SetCols в её пределах не выделяют память.
+  // При выходе за неё буфер растёт геометрически, поэтому добавление строк
+  // по одной стоит амортизированно O(cols). Уменьшение размеров буфер не
+  // освобождает - для этого есть ShrinkToFit(). Копирующее присваивание
+  // матрицы, помещающейся в ёмкость, тоже переиспользует буфер.
+  void Reserve(int rows, int cols);
+  void ShrinkToFit();
+  int GetRowCapacity() const noexcept;
+  int GetColCapacity() const noexcept;
+  std::pmr::memory_resource* GetResource() const noexcept;
+  // Представление всей матрицы или её блока без копирования,
+  // см. s21_matrix_view.h.
+  S21BasicMatrixView<T> View() const noexcept;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) const;
 
  private:
+  friend class S21BasicMatrixView<T>;
+  friend class S21BasicLU<T>;
+  friend class S21BasicCholesky<T>;
+  friend class S21BasicQR<T>;
+  friend class S21BasicSparseMatrix<T>;
+  friend class S21BasicBandMatrix<T>;
+  friend class S21BasicTriangularMatrix<T>;
+  friend class S21BasicSymmetricMatrix<T>;
+
   // Доп. функции:
-  void Allocate();
+  void Allocate(bool zero_fill = true);
   void Deallocate();
-  S21Matrix Minor(int rows, int cols);
-  void DelMatrix(double** matrix);
-  void AlocMatrix(double*** matrix, int rows, int cols);
+  S21BasicMatrix Minor(int rows, int cols);
+  void ComplementsByLu(S21BasicMatrix& result) const;
+  void DelMatrix(T* matrix, std::size_t count);
+  T* AlocMatrix(int rows, int cols, bool zero_fill = true);
+  void CopyElements(const S21BasicMatrix& other);
+  void MoveFrom(S21BasicMatrix& other) noexcept;
+  void Reallocate(int row_capacity, int stride);
+  std::size_t BufferCapacity(int rows, int cols) const noexcept;
+  template <typename E>
+  void Assign(const E& expr);
+
+  // Элементы хранятся одним выровненным буфером построчно (row-major),
+  // stride_ - расстояние между началами соседних строк в элементах.
+  static constexpr std::size_t kAlignment = 64;
 
   int rows_ = {0};
   int cols_ = {0};
-  double** matrix_ = nullptr;
+  int stride_ = {0};
+  // Число элементов в выделенном буфере (для встроенного -
+  // kInlineCapacity). Строки занимают rows_ * stride_ из них.
+  std::size_t capacity_ = {0};
+  T* matrix_ = nullptr;
+  std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+  // Буфер передан через Wrap или Adopt; deleter_ пуст для Wrap.
+  bool external_ = false;
+  std::function<void(T*)> deleter_;
+  // Встроенный буфер малых матриц: matrix_ == inline_.
+  alignas(kAlignment) T inline_[kInlineCapacity];
+
+  bool IsInline() const noexcept { return matrix_ == inline_; }
+
+  T* Row(int i) noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  const T* Row(int i) const noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
 
   bool SquareMatrix() { return rows_ == cols_; }
 
-  bool EqualColsRowsOfTwoMatrix(const S21Matrix& other) {
+  bool EqualColsRowsOfTwoMatrix(const S21BasicMatrix& other) {
     return cols_ == other.rows_;
   }
 
-  bool EqualSizeMatrix(const S21Matrix& other) const {
+  bool EqualSizeMatrix(const S21BasicMatrix& other) const {
     return (cols_ == other.cols_ && rows_ == other.rows_);
   }
 };
 
-S21Matrix operator*(const double num, const S21Matrix& other) noexcept;
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+#include "s21_matrix_expr.h"
 
 #endif  // S21_MATRIX_OOP_H_
@@ -1,6 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_decomposition.h"
+#include "s21_matrix_kernels.h"
+#include "s21_memory_resource.h"
 #include "s21_matrix_oop.h"
+#include "s21_sparse_matrix.h"
+#include "s21_structured_matrix.h"
+#include "s21_thread_pool.h"
 
 TEST(Constructor, DefaultConstructorTest_1) {
   S21Matrix mat;
@@ -671,7 +686,7 @@ TEST(Transpose, test_22) {
   res2 = a.Determinant();
 
   EXPECT_EQ(b.EqMatrix(result), true);
-  EXPECT_EQ(res1, res2);
+  EXPECT_NEAR(res1, res2, 1e-7);
 }
 
 TEST(Determinant, test_23) {
@@ -1769,6 +1784,1467 @@ TEST(Move, False) {
   EXPECT_EQ(matrix1.GetCols(), 0);
 }
 
+TEST(Det, True4) {
+  S21Matrix matrix_a(12, 12);
+  for (int i = 0; i < 12; i++) {
+    for (int j = 0; j < 12; j++) {
+      matrix_a(i, j) = (i == j) ? 2 : 1;
+    }
+  }
+  matrix_a(0, 0) = 1;
+  matrix_a(0, 1) = 2;
+  matrix_a(1, 0) = 2;
+  matrix_a(1, 1) = 1;
+
+  EXPECT_NEAR(matrix_a.Determinant(), -13, 1e-7);
+}
+
+TEST(Det, True5) {
+  S21Matrix matrix_a(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix_a(i, j) = i * 4 + j + 1;
+    }
+  }
+
+  EXPECT_NEAR(matrix_a.Determinant(), 0, 1e-7);
+}
+
+TEST(InverseMatrix3, True) {
+  const int size = 50;
+  S21Matrix matrix_a(size, size);
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      matrix_a(i, j) = 1.0 / (i + j + 1) + (i == j ? size : 0);
+    }
+    identity(i, i) = 1;
+  }
+
+  S21Matrix inverse = matrix_a.InverseMatrix();
+
+  EXPECT_TRUE(matrix_a * inverse == identity);
+}
+
+TEST(InverseMatrix3, False) {
+  S21Matrix matrix_a(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix_a(i, j) = i * 4 + j + 1;
+    }
+  }
+  S21Matrix matrix_b(2, 3);
+
+  EXPECT_THROW(matrix_a.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(matrix_b.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(MulMatrix, Blocked) {
+  const int rows = 131, inner = 300, cols = 77;
+  S21Matrix matrix_a(rows, inner);
+  S21Matrix matrix_b(inner, cols);
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int k = 0; k < inner; k++) matrix_a(i, k) = (i * 7 + k * 3) % 11 - 5;
+  }
+  for (int k = 0; k < inner; k++) {
+    for (int j = 0; j < cols; j++) matrix_b(k, j) = (k * 5 + j) % 13 - 6;
+  }
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      for (int k = 0; k < inner; k++) {
+        result(i, j) += matrix_a(i, k) * matrix_b(k, j);
+      }
+    }
+  }
+
+  matrix_a.MulMatrix(matrix_b);
+
+  EXPECT_EQ(matrix_a.GetRows(), rows);
+  EXPECT_EQ(matrix_a.GetCols(), cols);
+  EXPECT_TRUE(matrix_a == result);
+}
+
+TEST(MulMatrix, MulAdd) {
+  // Маленький (GemmSmall) и блочный путь Gemm.
+  for (int n : {4, 70}) {
+    S21Matrix a(n + 3, n);
+    S21Matrix b(n, n + 1);
+    S21Matrix c(n + 3, n + 1);
+    for (int i = 0; i < a.GetRows(); ++i) {
+      for (int j = 0; j < a.GetCols(); ++j) a(i, j) = std::sin(i + 2 * j);
+    }
+    for (int i = 0; i < b.GetRows(); ++i) {
+      for (int j = 0; j < b.GetCols(); ++j) b(i, j) = std::cos(3 * i - j);
+    }
+    for (int i = 0; i < c.GetRows(); ++i) {
+      for (int j = 0; j < c.GetCols(); ++j) c(i, j) = i - j;
+    }
+    S21Matrix expected = c * 0.5 + (a * b) * 2.0;
+    S21Matrix result(c);
+    result.MulAdd(2.0, a, b, 0.5);
+    EXPECT_TRUE(result.EqMatrix(expected));
+
+    S21Matrix at = a.Transpose();
+    S21Matrix bt = b.Transpose();
+    result = c;
+    result.MulAdd(2.0, at, bt, 0.5, S21Transpose::kTranspose,
+                  S21Transpose::kTranspose);
+    EXPECT_TRUE(result.EqMatrix(expected));
+    result = c;
+    result.MulAdd(2.0, a, bt, 0.5, S21Transpose::kNone,
+                  S21Transpose::kTranspose);
+    EXPECT_TRUE(result.EqMatrix(expected));
+
+    // beta == 0 не читает прежние элементы.
+    for (int i = 0; i < result.GetRows(); ++i) {
+      for (int j = 0; j < result.GetCols(); ++j) {
+        result(i, j) = std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+    result.MulAdd(1.0, a, b, 0.0);
+    EXPECT_TRUE(result.EqMatrix(a * b));
+  }
+
+  // Множитель - сама матрица.
+  S21Matrix c(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) c(i, j) = i * 3 + j + 1;
+  }
+  S21Matrix expected = c * c + c;
+  c.MulAdd(1.0, c, c, 1.0);
+  EXPECT_TRUE(c.EqMatrix(expected));
+
+  S21Matrix a(2, 3);
+  EXPECT_THROW(c.MulAdd(1.0, a, a, 1.0), std::invalid_argument);
+  EXPECT_NO_THROW(c.MulAdd(1.0, a, a, 1.0, S21Transpose::kTranspose));
+}
+
+TEST(MulMatrix, Strassen) {
+  const int previous = s21_kernels::GetStrassenCrossover();
+  for (int n : {64, 131, 200}) {
+    S21Matrix a(n, n);
+    S21Matrix b(n, n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        a(i, j) = (i * 7 + j * 3) % 11 - 5;
+        b(i, j) = (i * 5 + j) % 13 - 6;
+      }
+    }
+    s21_kernels::SetStrassenCrossover(0);
+    S21Matrix classic = a * b;
+    s21_kernels::SetStrassenCrossover(40);
+    // Целые значения складываются без округления - результат точный.
+    S21Matrix fast = a * b;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) ASSERT_EQ(fast(i, j), classic(i, j));
+    }
+
+    // Нецелые: ошибка в пределах нормовой оценки из s21_matrix_kernels.h.
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        a(i, j) = std::sin(i * 0.37 + j * 1.3);
+        b(i, j) = std::cos(i * 0.11 - j * 0.7);
+      }
+    }
+    fast = a * b;
+    s21_kernels::SetStrassenCrossover(0);
+    classic = a * b;
+    // Листья не меньше 20 (crossover / 2).
+    const double bound =
+        (std::pow(n / 20.0, std::log2(18.0)) * (20 * 20 + 6 * 20) - 6 * n) *
+        std::numeric_limits<double>::epsilon();
+    double error = 0;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        error = std::max(error, std::fabs(fast(i, j) - classic(i, j)));
+      }
+    }
+    EXPECT_LE(error, bound);
+  }
+  s21_kernels::SetStrassenCrossover(previous);
+  EXPECT_EQ(s21_kernels::GetStrassenCrossover(), previous);
+}
+
+TEST(Batch, MatchesSingleMatrices) {
+  // 37 матриц: два полных блока и неполный хвост.
+  for (int n : {3, 5}) {
+    const int count = 37;
+    S21MatrixBatch a(count, n, n);
+    S21MatrixBatch b(count, n, n);
+    for (int k = 0; k < count; ++k) {
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          a(k, i, j) = std::sin(k * 7 + i * n + j) + (i == j ? n : 0);
+          b(k, i, j) = std::cos(k * 3 + i - 2 * j);
+        }
+      }
+    }
+    const S21MatrixBatch product = a.BatchMulMatrix(b);
+    const S21MatrixBatch transposed = b.BatchTranspose();
+    const S21MatrixBatch inverse = a.BatchInverseMatrix();
+    const std::vector<double> det = a.BatchDeterminant();
+    ASSERT_EQ(det.size(), static_cast<std::size_t>(count));
+    for (int k = 0; k < count; ++k) {
+      S21Matrix x = a.Get(k);
+      S21Matrix y = b.Get(k);
+      EXPECT_NEAR(det[k], x.Determinant(), 1e-9 * std::fabs(det[k]));
+      EXPECT_TRUE(inverse.Get(k).EqMatrix(x.InverseMatrix()));
+      EXPECT_TRUE(transposed.Get(k).EqMatrix(y.Transpose()));
+      x.MulMatrix(y);
+      EXPECT_TRUE(product.Get(k).EqMatrix(x));
+    }
+  }
+
+  S21MatrixBatch rect(5, 2, 3);
+  rect.Set(4, S21Matrix(2, 3));
+  EXPECT_EQ(rect.BatchTranspose().GetRows(), 3);
+  EXPECT_EQ(rect.BatchMulMatrix(rect.BatchTranspose()).GetCols(), 2);
+  EXPECT_THROW(rect.BatchDeterminant(), std::invalid_argument);
+  EXPECT_THROW(rect.BatchMulMatrix(rect), std::invalid_argument);
+  EXPECT_THROW(rect(5, 0, 0), std::out_of_range);
+  EXPECT_THROW(rect.Set(0, S21Matrix(3, 2)), std::invalid_argument);
+
+  // Много 3x3 - параллельный путь; одна вырожденная матрица.
+  S21MatrixBatch many(20000, 3, 3);
+  for (int k = 0; k < many.GetCount(); ++k) {
+    for (int i = 0; i < 3; ++i) many(k, i, i) = k % 5 + 1;
+  }
+  const std::vector<double> det = many.BatchDeterminant();
+  const S21MatrixBatch inverse = many.BatchInverseMatrix();
+  for (int k = 0; k < many.GetCount(); k += 997) {
+    EXPECT_DOUBLE_EQ(det[k], std::pow(k % 5 + 1, 3));
+    EXPECT_DOUBLE_EQ(inverse(k, 1, 1), 1.0 / (k % 5 + 1));
+  }
+  many(12345, 2, 2) = 0;
+  EXPECT_DOUBLE_EQ(many.BatchDeterminant()[12345], 0);
+  EXPECT_THROW(many.BatchInverseMatrix(), std::invalid_argument);
+}
+
+TEST(Simd, AllLevels) {
+  const s21_kernels::SimdLevel initial = s21_kernels::GetSimdLevel();
+  const int rows = 37, inner = 45, cols = 83;
+  S21Matrix matrix_a(rows, inner);
+  S21Matrix matrix_b(rows, inner);
+  S21Matrix matrix_c(inner, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < inner; j++) {
+      matrix_a(i, j) = (i * 3 + j) % 17 - 8;
+      matrix_b(i, j) = (i + j * 5) % 19 - 9;
+    }
+  }
+  for (int i = 0; i < inner; i++) {
+    for (int j = 0; j < cols; j++) matrix_c(i, j) = (i * j) % 7 - 3;
+  }
+  S21Matrix sum(rows, inner);
+  S21Matrix sub(rows, inner);
+  S21Matrix scaled(rows, inner);
+  S21Matrix product(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < inner; j++) {
+      sum(i, j) = matrix_a(i, j) + matrix_b(i, j);
+      sub(i, j) = matrix_a(i, j) - matrix_b(i, j);
+      scaled(i, j) = matrix_a(i, j) * 2.5;
+    }
+    for (int j = 0; j < cols; j++) {
+      for (int k = 0; k < inner; k++) {
+        product(i, j) += matrix_a(i, k) * matrix_c(k, j);
+      }
+    }
+  }
+
+  for (auto level :
+       {s21_kernels::SimdLevel::kScalar, s21_kernels::SimdLevel::kSse2,
+        s21_kernels::SimdLevel::kAvx2, s21_kernels::SimdLevel::kAvx512}) {
+    s21_kernels::SetSimdLevel(level);
+    S21Matrix matrix_d = matrix_a;
+    matrix_d.SumMatrix(matrix_b);
+    EXPECT_TRUE(matrix_d == sum);
+    matrix_d = matrix_a;
+    matrix_d.SubMatrix(matrix_b);
+    EXPECT_TRUE(matrix_d == sub);
+    matrix_d = matrix_a;
+    matrix_d.MulNumber(2.5);
+    EXPECT_TRUE(matrix_d == scaled);
+    matrix_d(rows - 1, inner - 1) += 1e-6;
+    EXPECT_FALSE(matrix_d == scaled);
+    matrix_d = matrix_a;
+    matrix_d.MulMatrix(matrix_c);
+    EXPECT_TRUE(matrix_d == product);
+  }
+  s21_kernels::SetSimdLevel(initial);
+}
+
+TEST(MulMatrix, Parallel) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  const int initial = pool.GetThreadCount();
+  const int size = 150;
+  S21Matrix matrix_a(size, size + 7);
+  S21Matrix matrix_b(size + 7, size - 3);
+  for (int i = 0; i < matrix_a.GetRows(); i++) {
+    for (int j = 0; j < matrix_a.GetCols(); j++) {
+      matrix_a(i, j) = (i * 13 + j * 7) % 23 - 11;
+    }
+  }
+  for (int i = 0; i < matrix_b.GetRows(); i++) {
+    for (int j = 0; j < matrix_b.GetCols(); j++) {
+      matrix_b(i, j) = (i * 3 + j * 11) % 17 - 8;
+    }
+  }
+
+  pool.SetThreadCount(1);
+  S21Matrix serial = matrix_a * matrix_b;
+  pool.SetThreadCount(5);
+  EXPECT_EQ(pool.GetThreadCount(), 5);
+  S21Matrix parallel = matrix_a * matrix_b;
+  pool.SetThreadCount(initial);
+
+  EXPECT_TRUE(serial == parallel);
+  EXPECT_THROW(pool.SetThreadCount(0), std::invalid_argument);
+}
+
+TEST(ThreadPool, ParallelFor) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  const int initial = pool.GetThreadCount();
+  pool.SetThreadCount(4);
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(1000, [&hits](int i) { hits[i]++; });
+  EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 1000);
+  EXPECT_THROW(pool.ParallelFor(10,
+                                [](int i) {
+                                  if (i == 7) throw std::runtime_error("7");
+                                }),
+               std::runtime_error);
+
+  // Число потоков читается во время SetThreadCount() из другого потока.
+  std::atomic<bool> done{false};
+  std::thread reader([&pool, &done] {
+    while (!done.load()) {
+      const int count = pool.GetThreadCount();
+      EXPECT_TRUE(count >= 1 && count <= 4);
+    }
+  });
+  for (int i = 0; i < 20; ++i) pool.SetThreadCount(i % 2 == 0 ? 2 : 4);
+  done.store(true);
+  reader.join();
+  pool.SetThreadCount(initial);
+}
+
+TEST(Expression, Chain) {
+  S21Matrix matrix_a(3, 4);
+  S21Matrix matrix_b(3, 4);
+  S21Matrix matrix_c(3, 4);
+  S21Matrix result(3, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix_a(i, j) = i + j;
+      matrix_b(i, j) = i * j;
+      matrix_c(i, j) = i - j;
+      result(i, j) = (i + j) + (i * j) - (i - j) * 2.0;
+    }
+  }
+
+  S21Matrix matrix_d = matrix_a + matrix_b - matrix_c * 2.0;
+  EXPECT_TRUE(matrix_d == result);
+  EXPECT_TRUE((matrix_a + matrix_b - 2.0 * matrix_c) == result);
+
+  matrix_a = matrix_a + matrix_b - matrix_c * 2.0;
+  EXPECT_TRUE(matrix_a == result);
+
+  S21Matrix matrix_e(1, 1);
+  matrix_e = (matrix_d - result) * 3;
+  EXPECT_EQ(matrix_e.GetRows(), 3);
+  EXPECT_EQ(matrix_e.GetCols(), 4);
+  EXPECT_TRUE(matrix_e == S21Matrix(3, 4));
+}
+
+TEST(Expression, SizeMismatch) {
+  S21Matrix matrix_a(2, 2);
+  S21Matrix matrix_b(3, 3);
+  S21Matrix result(2, 2);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      matrix_a(i, j) = 1.0;
+      result(i, j) = 2.0;
+    }
+  }
+  matrix_b(0, 0) = 5.0;
+
+  S21Matrix matrix_c = (matrix_a + matrix_b) * 2.0;
+
+  EXPECT_TRUE(matrix_c == result);
+}
+
+TEST(Expression, ProductAllocations) {
+  S21CountingResource counter;
+  S21Matrix matrix_a(6, 6, &counter);
+  S21Matrix matrix_b(6, 6, &counter);
+  S21Matrix matrix_c(6, 6, &counter);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      matrix_a(i, j) = i + j;
+      matrix_b(i, j) = i == j;
+      matrix_c(i, j) = 1;
+    }
+  }
+  counter.ResetCounters();
+  S21Matrix product = matrix_a * matrix_b;
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  EXPECT_TRUE(product == matrix_a);
+
+  counter.ResetCounters();
+  S21Matrix sum = (matrix_a * matrix_b) + matrix_c;
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  EXPECT_TRUE(sum == matrix_a + matrix_c);
+
+  S21Matrix matrix_d(4, 6, &counter);
+  counter.ResetCounters();
+  S21Matrix mismatch = matrix_a * matrix_d;
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  EXPECT_TRUE(mismatch == matrix_a);
+}
+
+TEST(Expression, ReuseTemporary) {
+  // Больше встроенного буфера, иначе буфер не переиспользуется, а копируется.
+  const int size = 5;
+  S21Matrix matrix_a(size, size);
+  S21Matrix matrix_b(size, size);
+  S21Matrix matrix_c(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      matrix_a(i, j) = i + j;
+      matrix_b(i, j) = i == j;
+      matrix_c(i, j) = 1;
+    }
+  }
+  S21Matrix result = matrix_a;
+  result += matrix_c;
+
+  S21Matrix product = matrix_a * matrix_b;
+  const double *buffer = &product(0, 0);
+  S21Matrix sum = std::move(product) + matrix_c;
+  EXPECT_EQ(&sum(0, 0), buffer);
+  EXPECT_TRUE(sum == result);
+
+  S21Matrix diff = matrix_c - std::move(sum);
+  EXPECT_EQ(&diff(0, 0), buffer);
+  EXPECT_TRUE(diff == matrix_c - result);
+
+  S21Matrix scaled = 2 * std::move(diff) * 0.5;
+  EXPECT_EQ(&scaled(0, 0), buffer);
+  EXPECT_TRUE(scaled == matrix_c - result);
+
+  EXPECT_TRUE((matrix_a * matrix_b) + (matrix_c * matrix_b) == result);
+  EXPECT_TRUE((matrix_a * matrix_b) - (matrix_c * matrix_b) + matrix_c ==
+              matrix_a);
+}
+
+TEST(FixedMatrix, Constexpr) {
+  constexpr S21FixedMatrix<3, 3> matrix_a = {1, 2, 3, 0, 4, 2, 5, 2, 1};
+  constexpr S21FixedMatrix<3, 2> matrix_b = {1, 0, 0, 1, 1, 1};
+  static_assert(matrix_a.Determinant() == -40, "");
+  static_assert((matrix_a * matrix_b)(2, 1) == 3, "");
+  static_assert(matrix_b.Transpose().GetRows() == 2, "");
+  static_assert(matrix_a.CalcComplements()(0, 1) == 10, "");
+
+  S21FixedMatrix<3, 3> inverse = matrix_a.InverseMatrix();
+  S21FixedMatrix<3, 3> identity = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  EXPECT_TRUE(matrix_a * inverse == identity);
+  inverse *= matrix_a;
+  EXPECT_TRUE(inverse == identity);
+  EXPECT_TRUE((2 * identity - identity * 1.5 + identity) * 2 == 3 * identity);
+}
+
+TEST(FixedMatrix, MatchesDynamic) {
+  S21FixedMatrix<5, 5> fixed;
+  S21Matrix dynamic(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      fixed(i, j) = (i * 7 + j * 3) % 11 + (i == j ? 4 : 0);
+      dynamic(i, j) = fixed(i, j);
+    }
+  }
+
+  EXPECT_TRUE((S21FixedMatrix<5, 5>(dynamic) == fixed));
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-7);
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed.CalcComplements()) ==
+              dynamic.CalcComplements());
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed.InverseMatrix()) ==
+              dynamic.InverseMatrix());
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed.Transpose()) ==
+              dynamic.Transpose());
+
+  S21FixedMatrix<1, 1> one = {5};
+  S21Matrix one_dynamic(1, 1);
+  one_dynamic(0, 0) = 5;
+  EXPECT_TRUE(static_cast<S21Matrix>(one.CalcComplements()) ==
+              one_dynamic.CalcComplements());
+  EXPECT_TRUE(static_cast<S21Matrix>(one.InverseMatrix()) ==
+              one_dynamic.InverseMatrix());
+
+  // Хорошо обусловленные матрицы любого масштаба обратимы.
+  for (double scale : {1e-40, 1e40}) {
+    S21FixedMatrix<9, 9> scaled;
+    for (int i = 0; i < 9; i++) scaled(i, i) = scale;
+    EXPECT_DOUBLE_EQ(scaled.InverseMatrix()(4, 4) * scale, 1.0);
+  }
+  // Вырожденность по одному и тому же порогу у обоих классов.
+  for (double delta : {1e-17, 2e-16, 1e-15}) {
+    S21FixedMatrix<2, 2> near = {1, 1, 1, 1 + delta};
+    S21Matrix near_dynamic(near);
+    bool fixed_singular = false, dynamic_singular = false;
+    try {
+      near.InverseMatrix();
+    } catch (const std::invalid_argument &) {
+      fixed_singular = true;
+    }
+    try {
+      near_dynamic.InverseMatrix();
+    } catch (const std::invalid_argument &) {
+      dynamic_singular = true;
+    }
+    EXPECT_EQ(fixed_singular, dynamic_singular);
+    EXPECT_EQ(fixed_singular, delta < 1e-15);
+  }
+}
+
+TEST(FixedMatrix, ScalarType) {
+  constexpr S21FixedMatrixLD<3, 3> matrix_a = {1, 2, 3, 0, 4, 2, 5, 2, 1};
+  static_assert(matrix_a.Determinant() == -40, "");
+
+  // Допуск EqMatrix берётся из S21MatrixTolerance<T>.
+  S21FixedMatrixF<2, 2> matrix_f = {1, 2, 3, 4};
+  S21FixedMatrixF<2, 2> close_f = {1, 2, 3, 4.00001f};
+  EXPECT_TRUE(matrix_f == close_f);
+  S21FixedMatrix<2, 2> matrix_d = {1, 2, 3, 4};
+  S21FixedMatrix<2, 2> close_d = {1, 2, 3, 4.00001};
+  EXPECT_FALSE(matrix_d == close_d);
+
+  const S21MatrixF dynamic(matrix_f.InverseMatrix());
+  const S21FixedMatrixF<2, 2> identity = {1, 0, 0, 1};
+  EXPECT_TRUE((S21FixedMatrixF<2, 2>(dynamic) * matrix_f == identity));
+}
+
+TEST(FixedMatrix, Errors) {
+  S21FixedMatrix<2, 2> singular = {1, 2, 2, 4};
+  S21Matrix dynamic(2, 3);
+
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW((S21FixedMatrix<2, 2>(dynamic)), std::invalid_argument);
+  EXPECT_THROW(singular(2, 0), std::out_of_range);
+  EXPECT_THROW((S21FixedMatrix<1, 2>{1, 2, 3}), std::invalid_argument);
+}
+
+TEST(ScalarType, Float) {
+  const s21_kernels::SimdLevel initial = s21_kernels::GetSimdLevel();
+  const int rows = 21, inner = 35, cols = 19;
+  S21MatrixF matrix_a(rows, inner);
+  S21MatrixF matrix_b(inner, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < inner; j++) matrix_a(i, j) = (i * 5 + j) % 11 - 5;
+  }
+  for (int i = 0; i < inner; i++) {
+    for (int j = 0; j < cols; j++) matrix_b(i, j) = (i + j * 3) % 7 - 3;
+  }
+  S21MatrixF product(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      for (int k = 0; k < inner; k++) {
+        product(i, j) += matrix_a(i, k) * matrix_b(k, j);
+      }
+    }
+  }
+
+  for (auto level :
+       {s21_kernels::SimdLevel::kScalar, s21_kernels::SimdLevel::kSse2,
+        s21_kernels::SimdLevel::kAvx2, s21_kernels::SimdLevel::kAvx512}) {
+    s21_kernels::SetSimdLevel(level);
+    EXPECT_TRUE(matrix_a * matrix_b == product);
+    S21MatrixF sum = matrix_a + matrix_a * 2.0f;
+    S21MatrixF scaled = matrix_a * 3.0f;
+    EXPECT_TRUE(sum == scaled);
+    scaled(rows - 1, inner - 1) += 1e-3f;
+    EXPECT_FALSE(sum == scaled);
+  }
+  s21_kernels::SetSimdLevel(initial);
+}
+
+TEST(ScalarType, LongDouble) {
+  const int size = 6;
+  S21MatrixLD matrix(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      matrix(i, j) = (i == j) ? 2.0L : 1.0L / (i + j + 1);
+    }
+  }
+  S21MatrixLD identity(size, size);
+  for (int i = 0; i < size; i++) identity(i, i) = 1.0L;
+
+  EXPECT_TRUE(matrix * matrix.InverseMatrix() == identity);
+  S21MatrixLD shifted = matrix;
+  shifted(0, 0) += 1e-9L;
+  EXPECT_FALSE(shifted == matrix);
+
+  S21MatrixLD triangular(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = i; j < size; j++) triangular(i, j) = i + j + 1.0L;
+  }
+  long double expected = 1.0L;
+  for (int i = 0; i < size; i++) expected *= 2.0L * i + 1.0L;
+  EXPECT_NEAR(static_cast<double>(triangular.Determinant()),
+              static_cast<double>(expected), 1e-6);
+}
+
+TEST(MemoryResource, Arena) {
+  alignas(64) static unsigned char buffer[1 << 16];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  S21CountingResource counter(&arena);
+  {
+    S21Matrix matrix_a(5, 5, &counter);
+    S21Matrix matrix_b(5, 5, &counter);
+    for (int i = 0; i < 5; i++) {
+      for (int j = 0; j < 5; j++) {
+        matrix_a(i, j) = (i == j) ? 10 : i + j;
+        matrix_b(i, j) = i - j;
+      }
+    }
+    EXPECT_EQ(counter.GetAllocations(), 2u);
+
+    S21Matrix product = matrix_a * matrix_b;
+    S21Matrix inverse = matrix_a.InverseMatrix();
+    S21Matrix copy = inverse.Transpose();
+    copy = matrix_a + matrix_b;
+    S21Matrix sum = matrix_a + matrix_b;
+    S21Matrix scaled = matrix_b.View() * 2.0 + matrix_a;
+    EXPECT_EQ(product.GetResource(), &counter);
+    EXPECT_EQ(inverse.GetResource(), &counter);
+    EXPECT_EQ(copy.GetResource(), &counter);
+    EXPECT_EQ(sum.GetResource(), &counter);
+    EXPECT_EQ(scaled.GetResource(), &counter);
+    EXPECT_EQ(counter.GetAllocations(), 8u);
+    EXPECT_GT(counter.GetBytesInUse(), 0u);
+  }
+  EXPECT_EQ(counter.GetAllocations(), counter.GetDeallocations());
+  EXPECT_EQ(counter.GetBytesInUse(), 0u);
+  EXPECT_GE(counter.GetPeakBytes(), 5 * 25 * sizeof(double));
+
+  counter.ResetCounters();
+  S21Matrix defaulted(2, 2);
+  EXPECT_EQ(defaulted.GetResource(), std::pmr::get_default_resource());
+  S21Matrix moved(&counter);
+  moved = std::move(defaulted);
+  EXPECT_EQ(moved.GetResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(counter.GetAllocations(), 0u);
+}
+
+TEST(SmallMatrix, Inline) {
+  S21CountingResource counter;
+  S21Matrix matrix_a(4, 4, &counter);
+  S21Matrix matrix_b(4, 4, &counter);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix_a(i, j) = (i == j) ? 5 : i - j;
+      matrix_b(i, j) = i * j + 1;
+    }
+  }
+  S21Matrix product = matrix_a * matrix_b;
+  S21Matrix sum = product + matrix_a * 2.0;
+  S21Matrix inverse = matrix_a.InverseMatrix();
+  S21Matrix identity = matrix_a * inverse;
+  EXPECT_NEAR(identity(1, 1), 1, 1e-7);
+  EXPECT_NEAR(identity(2, 3), 0, 1e-7);
+  EXPECT_NE(matrix_a.Determinant(), 0);
+  S21Matrix complements = matrix_a.CalcComplements().Transpose();
+  EXPECT_EQ(counter.GetAllocations(), 0u);
+
+  S21Matrix moved = std::move(sum);
+  EXPECT_EQ(sum.GetRows(), 0);
+  EXPECT_DOUBLE_EQ(moved(0, 0), product(0, 0) + 10);
+  sum = std::move(moved);
+  EXPECT_DOUBLE_EQ(sum(3, 3), product(3, 3) + 10);
+
+  matrix_b.SetCols(2);
+  EXPECT_DOUBLE_EQ(matrix_b(3, 1), 4);
+  matrix_b.SetRows(8);
+  EXPECT_DOUBLE_EQ(matrix_b(3, 1), 4);
+  EXPECT_DOUBLE_EQ(matrix_b(7, 1), 0);
+  EXPECT_EQ(counter.GetAllocations(), 0u);
+  matrix_b.SetCols(3);
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  EXPECT_DOUBLE_EQ(matrix_b(2, 1), 3);
+  EXPECT_DOUBLE_EQ(matrix_b(2, 2), 0);
+}
+
+TEST(Capacity, AppendRows) {
+  S21CountingResource counter;
+  const int cols = 7, rows = 1000;
+  S21Matrix matrix(1, cols, &counter);
+  for (int i = 0; i < rows; i++) {
+    matrix.SetRows(i + 1);
+    for (int j = 0; j < cols; j++) matrix(i, j) = i * cols + j;
+  }
+  EXPECT_LE(counter.GetAllocations(), 12u);
+  EXPECT_GE(matrix.GetRowCapacity(), rows);
+  for (int i = 0; i < rows; i += 37) {
+    EXPECT_DOUBLE_EQ(matrix(i, cols - 1), i * cols + cols - 1);
+  }
+
+  const std::size_t allocations = counter.GetAllocations();
+  matrix.SetRows(10);
+  matrix.SetCols(3);
+  EXPECT_EQ(counter.GetAllocations(), allocations);
+  matrix.SetRows(11);
+  matrix.SetCols(5);
+  EXPECT_EQ(counter.GetAllocations(), allocations);
+  EXPECT_DOUBLE_EQ(matrix(9, 2), 9 * cols + 2);
+  EXPECT_DOUBLE_EQ(matrix(9, 4), 0);
+  EXPECT_DOUBLE_EQ(matrix(10, 0), 0);
+
+  S21Matrix copy = matrix;
+  EXPECT_TRUE(copy == matrix);
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.GetRowCapacity(), 11);
+  EXPECT_EQ(matrix.GetColCapacity(), 5);
+  EXPECT_TRUE(copy == matrix);
+  EXPECT_EQ(counter.GetBytesInUse(), 2 * 11 * 5 * sizeof(double));
+
+  matrix.Reserve(40, 6);
+  EXPECT_GE(matrix.GetRowCapacity(), 40);
+  EXPECT_EQ(matrix.GetColCapacity(), 6);
+  EXPECT_TRUE(copy == matrix);
+  const std::size_t reserved = counter.GetAllocations();
+  matrix.SetCols(6);
+  matrix.SetRows(40);
+  EXPECT_EQ(counter.GetAllocations(), reserved);
+  EXPECT_THROW(matrix.Reserve(-1, 2), std::invalid_argument);
+  EXPECT_THROW(matrix.SetRows(-1), std::invalid_argument);
+}
+
+TEST(Capacity, CopyAssign) {
+  S21CountingResource counter;
+  S21Matrix source(8, 8, &counter);
+  S21Matrix small(3, 5, &counter);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) source(i, j) = i * 8 + j;
+  }
+  small(2, 4) = 7;
+  S21Matrix matrix(8, 8, &counter);
+  counter.ResetCounters();
+  for (int k = 0; k < 10; k++) {
+    matrix = source;
+    matrix(0, 0) = k;
+  }
+  EXPECT_EQ(counter.GetAllocations(), 0u);
+  EXPECT_DOUBLE_EQ(matrix(7, 7), 63);
+
+  matrix = small;
+  EXPECT_EQ(matrix.GetRows(), 3);
+  EXPECT_EQ(matrix.GetCols(), 5);
+  EXPECT_TRUE(matrix == small);
+  matrix = source;
+  EXPECT_TRUE(matrix == source);
+  EXPECT_EQ(counter.GetAllocations(), 0u);
+
+  S21Matrix grown(9, 8, &counter);
+  grown(8, 7) = 1;
+  counter.ResetCounters();
+  matrix = grown;
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  EXPECT_EQ(counter.GetDeallocations(), 1u);
+  EXPECT_TRUE(matrix == grown);
+}
+
+TEST(MatrixView, Blocks) {
+  S21Matrix matrix(6, 7);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 7; j++) matrix(i, j) = (i * 7 + j) % 5 + (i == j) * 9;
+  }
+  S21MatrixView block = matrix.Block(1, 2, 4, 4);
+  EXPECT_EQ(block.GetRows(), 4);
+  EXPECT_EQ(block.GetCols(), 4);
+  EXPECT_EQ(block.Data(), &matrix(1, 2));
+  EXPECT_DOUBLE_EQ(block(3, 3), matrix(4, 5));
+  EXPECT_THROW(block(4, 0), std::out_of_range);
+  EXPECT_THROW(matrix.Block(3, 3, 4, 4), std::out_of_range);
+
+  S21Matrix copy(block);
+  EXPECT_TRUE(copy == block);
+  EXPECT_TRUE(block == copy);
+  EXPECT_TRUE(copy.EqMatrix(block));
+  EXPECT_DOUBLE_EQ(block.Determinant(), copy.Determinant());
+  EXPECT_TRUE(block.Transpose() == copy.Transpose());
+
+  S21MatrixView column = matrix.View().ColView(3);
+  S21MatrixView row = matrix.View().RowView(2);
+  EXPECT_EQ(column.GetRows(), 6);
+  EXPECT_DOUBLE_EQ(column(5, 0), matrix(5, 3));
+  S21Matrix outer = column * row;
+  EXPECT_EQ(outer.GetRows(), 6);
+  EXPECT_EQ(outer.GetCols(), 7);
+  EXPECT_DOUBLE_EQ(outer(4, 6), matrix(4, 3) * matrix(2, 6));
+  S21Matrix dot = row * column.Block(0, 0, 6, 1).Transpose();
+  EXPECT_EQ(dot.GetRows(), 1);
+
+  S21Matrix product = block * copy;
+  EXPECT_TRUE(product == copy * copy);
+  S21Matrix left(matrix.Block(0, 0, 4, 4));
+  left.MulMatrix(block);
+  EXPECT_TRUE(left == S21Matrix(matrix.Block(0, 0, 4, 4)) * copy);
+
+  S21Matrix sum = block + copy * 2.0;
+  EXPECT_TRUE(sum == copy * 3.0);
+}
+
+TEST(ExternalBuffer, WrapAndAdopt) {
+  std::vector<double> buffer(5 * 8);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 8; j++) buffer[i * 8 + j] = i * 10 + j;
+  }
+  {
+    S21Matrix wrapped = S21Matrix::Wrap(buffer.data(), 5, 6, 8);
+    EXPECT_EQ(&wrapped(0, 0), buffer.data());
+    EXPECT_DOUBLE_EQ(wrapped(4, 5), 45);
+    wrapped(1, 1) = -1;
+    wrapped.MulNumber(2);
+    S21Matrix moved = std::move(wrapped);
+    EXPECT_EQ(&moved(0, 0), buffer.data());
+  }
+  EXPECT_DOUBLE_EQ(buffer[9], -2);
+  EXPECT_DOUBLE_EQ(buffer[4 * 8 + 5], 90);
+  EXPECT_DOUBLE_EQ(buffer[4 * 8 + 6], 46);
+  {
+    // Расширение по столбцам не трогает запас строк чужого буфера.
+    S21Matrix wrapped = S21Matrix::Wrap(buffer.data(), 5, 6, 8);
+    EXPECT_EQ(wrapped.GetColCapacity(), 6);
+    wrapped.SetCols(7);
+    EXPECT_NE(&wrapped(0, 0), buffer.data());
+    EXPECT_DOUBLE_EQ(wrapped(4, 5), 90);
+    EXPECT_DOUBLE_EQ(wrapped(4, 6), 0);
+    wrapped(0, 0) = 100;
+  }
+  EXPECT_DOUBLE_EQ(buffer[0], 0);
+  EXPECT_DOUBLE_EQ(buffer[4 * 8 + 6], 46);
+  EXPECT_DOUBLE_EQ(buffer[2 * 8 + 7], 27);
+
+  int deleted = 0;
+  double *owned = new double[4 * 6];
+  for (int i = 0; i < 24; i++) owned[i] = i;
+  {
+    S21Matrix adopted =
+        S21Matrix::Adopt(owned, 4, 6, [&deleted](double *data) {
+          ++deleted;
+          delete[] data;
+        });
+    EXPECT_DOUBLE_EQ(adopted(3, 5), 23);
+    adopted.SetRows(3);
+    EXPECT_EQ(deleted, 0);
+    adopted.SetRows(9);
+    EXPECT_EQ(deleted, 1);
+    EXPECT_DOUBLE_EQ(adopted(2, 5), 17);
+    EXPECT_DOUBLE_EQ(adopted(3, 5), 0);
+  }
+  EXPECT_EQ(deleted, 1);
+
+  EXPECT_THROW(S21Matrix::Wrap(nullptr, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Wrap(buffer.data(), 2, 8, 4),
+               std::invalid_argument);
+}
+
+TEST(ExternalBuffer, ColMajorView) {
+  // Тот же 3x4, что и row_major, но по столбцам с ведущей размерностью 5.
+  const double row_major[] = {1, 2, 3, 4, 5, 6, 7, 9, 2, 8, 1, 3};
+  double col_major[5 * 4] = {};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) col_major[j * 5 + i] = row_major[i * 4 + j];
+  }
+  S21MatrixView rows(row_major, 3, 4, 4);
+  S21MatrixView cols(col_major, 3, 4, 5, S21Layout::kColMajor);
+  EXPECT_FALSE(cols.IsRowMajor());
+  EXPECT_DOUBLE_EQ(cols(1, 3), 9);
+  EXPECT_TRUE(rows == cols);
+  EXPECT_TRUE(S21Matrix(cols) == rows);
+  EXPECT_TRUE(cols.Transpose() == rows.Transpose());
+  EXPECT_DOUBLE_EQ(cols.Block(0, 1, 3, 3).Determinant(),
+                   rows.Block(0, 1, 3, 3).Determinant());
+  EXPECT_TRUE(cols * cols.Transpose() == rows * rows.Transpose());
+  S21Matrix sum = cols + rows;
+  EXPECT_TRUE(sum == rows * 2.0);
+  EXPECT_THROW(S21MatrixView(col_major, 6, 4, 5, S21Layout::kColMajor),
+               std::invalid_argument);
+}
+
+TEST(Uninitialized, Construct) {
+  S21CountingResource counter;
+  S21Matrix matrix(20, 30, kS21Uninitialized, &counter);
+  EXPECT_EQ(matrix.GetResource(), &counter);
+  EXPECT_EQ(counter.GetAllocations(), 1u);
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 30; j++) matrix(i, j) = i - j;
+  }
+  S21Matrix transposed = matrix.Transpose();
+  EXPECT_DOUBLE_EQ(transposed(29, 19), -10);
+  S21Matrix copy = matrix;
+  EXPECT_TRUE(copy == matrix);
+
+  // Открывающиеся после перевыделения строки и столбцы нулевые.
+  matrix.Reserve(50, 40);
+  matrix.SetCols(35);
+  matrix.SetRows(45);
+  EXPECT_DOUBLE_EQ(matrix(19, 29), -10);
+  EXPECT_DOUBLE_EQ(matrix(19, 34), 0);
+  EXPECT_DOUBLE_EQ(matrix(44, 0), 0);
+
+  S21Matrix small(2, 2, kS21Uninitialized);
+  small(0, 0) = 1;
+  small(0, 1) = 2;
+  small(1, 0) = 3;
+  small(1, 1) = 4;
+  S21Matrix moved = std::move(small);
+  EXPECT_DOUBLE_EQ(moved.Determinant(), -2);
+  EXPECT_THROW(S21Matrix(0, 2, kS21Uninitialized), std::invalid_argument);
+}
+
+template <typename Matrix>
+void CheckTransposeAllLevels() {
+  const s21_kernels::SimdLevel initial = s21_kernels::GetSimdLevel();
+  const int sizes[][2] = {{1, 1}, {3, 70}, {67, 45}, {100, 100}, {9, 8}};
+  for (auto level :
+       {s21_kernels::SimdLevel::kScalar, s21_kernels::SimdLevel::kSse2,
+        s21_kernels::SimdLevel::kAvx2, s21_kernels::SimdLevel::kAvx512}) {
+    s21_kernels::SetSimdLevel(level);
+    for (const auto &size : sizes) {
+      Matrix matrix(size[0], size[1]);
+      for (int i = 0; i < size[0]; i++) {
+        for (int j = 0; j < size[1]; j++) matrix(i, j) = i * 1000 + j;
+      }
+      Matrix transposed = matrix.Transpose();
+      bool same = transposed.GetRows() == size[1];
+      for (int i = 0; i < size[0] && same; i++) {
+        for (int j = 0; j < size[1] && same; j++) {
+          same = transposed(j, i) == matrix(i, j);
+        }
+      }
+      EXPECT_TRUE(same);
+      Matrix in_place = matrix;
+      in_place.TransposeInPlace();
+      EXPECT_TRUE(in_place == transposed);
+      in_place.TransposeInPlace();
+      EXPECT_TRUE(in_place == matrix);
+    }
+  }
+  s21_kernels::SetSimdLevel(initial);
+}
+
+TEST(Transpose, Blocked) {
+  CheckTransposeAllLevels<S21Matrix>();
+  CheckTransposeAllLevels<S21MatrixF>();
+  CheckTransposeAllLevels<S21MatrixLD>();
+
+  S21Matrix matrix(70, 70);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 70; j++) matrix(i, j) = i - 2 * j;
+  }
+  S21CountingResource counter;
+  S21Matrix square(matrix.View(), &counter);
+  const std::size_t allocations = counter.GetAllocations();
+  square.TransposeInPlace();
+  EXPECT_EQ(counter.GetAllocations(), allocations);
+  EXPECT_TRUE(square == matrix.Transpose());
+  EXPECT_TRUE(matrix.Block(3, 5, 40, 61).Transpose() ==
+              S21Matrix(matrix.Block(3, 5, 40, 61)).Transpose());
+}
+
+// Дополнения по определению: (-1)^(i+j) * det(минора).
+S21Matrix ComplementsByMinors(const S21Matrix &matrix) {
+  const int n = matrix.GetRows();
+  S21Matrix result(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int r = 0, mr = 0; r < n; r++) {
+        if (r == i) continue;
+        for (int c = 0, mc = 0; c < n; c++) {
+          if (c != j) minor(mr, mc++) = matrix(r, c);
+        }
+        mr++;
+      }
+      result(i, j) = ((i + j) % 2 ? -1 : 1) * minor.Determinant();
+    }
+  }
+  return result;
+}
+
+TEST(CalcComplements, Lu) {
+  const int n = 6;
+  S21Matrix regular(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) regular(i, j) = (i * 7 + j * 3) % 11 - 5;
+  }
+  EXPECT_TRUE(regular.CalcComplements() == ComplementsByMinors(regular));
+
+  // Ранг n - 1: последняя строка - сумма первых двух.
+  S21Matrix rank_deficient = regular;
+  for (int j = 0; j < n; j++) {
+    rank_deficient(n - 1, j) = regular(0, j) + regular(1, j);
+  }
+  S21Matrix expected = ComplementsByMinors(rank_deficient);
+  EXPECT_TRUE(rank_deficient.CalcComplements() == expected);
+  double max = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) max = std::max(max, std::fabs(expected(i, j)));
+  }
+  EXPECT_GT(max, 1);
+
+  // Ранг n - 2: все дополнения нулевые.
+  for (int j = 0; j < n; j++) {
+    rank_deficient(n - 2, j) = regular(2, j) - regular(3, j);
+  }
+  EXPECT_TRUE(rank_deficient.CalcComplements() == S21Matrix(n, n));
+
+  S21Matrix large(200, 200);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) {
+      large(i, j) = (i == j) ? 4 : 1.0 / (i + j + 1);
+    }
+  }
+  S21Matrix complements = large.CalcComplements();
+  S21Matrix product = large * complements.Transpose();
+  const double det = large.Determinant();
+  EXPECT_NEAR(product(17, 17) / det, 1, 1e-9);
+  EXPECT_NEAR(product(17, 42) / det, 0, 1e-9);
+}
+
+TEST(Decomposition, Lu) {
+  const int n = 6;
+  S21Matrix a(n, n);
+  S21Matrix b(n, 3);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) a(i, j) = (i * 7 + j * 3) % 11 - 5;
+    for (int j = 0; j < 3; j++) b(i, j) = i - 2 * j;
+  }
+  S21CountingResource counter;
+  S21Matrix source(a.View(), &counter);
+  S21LU lu(source);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), a.Determinant(), 1e-9);
+  S21Matrix x = lu.Solve(b);
+  EXPECT_EQ(x.GetResource(), &counter);
+  EXPECT_TRUE(a * x == b);
+  EXPECT_TRUE(lu.Solve(b.Block(0, 1, n, 1)) == x.Block(0, 1, n, 1));
+  EXPECT_TRUE(lu.Inverse() == a.InverseMatrix());
+  // Правые части во внешнем буфере по столбцам.
+  std::vector<double> columns(2 * n);
+  for (int i = 0; i < 2 * n; i++) columns[i] = i % 5;
+  S21MatrixView column_major(columns.data(), n, 2, n, S21Layout::kColMajor);
+  EXPECT_TRUE(lu.Solve(column_major) == lu.Solve(S21Matrix(column_major)));
+
+  for (int j = 0; j < n; j++) a(n - 1, j) = a(0, j) + a(1, j);
+  S21LU singular(a);
+  EXPECT_TRUE(singular.IsSingular());
+  EXPECT_NEAR(singular.Determinant(), 0, 1e-9);
+  EXPECT_THROW(singular.Solve(b), std::invalid_argument);
+  EXPECT_THROW(singular.Inverse(), std::invalid_argument);
+  EXPECT_THROW(lu.Solve(S21Matrix(n + 1, 1)), std::invalid_argument);
+  EXPECT_THROW(S21LU(S21Matrix(2, 3)), std::invalid_argument);
+}
+
+TEST(Decomposition, Cholesky) {
+  const int n = 7;
+  // A = M^T * M + n * I симметрична и положительно определена.
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) m(i, j) = (i * 5 + j * 2) % 7 - 3;
+  }
+  S21Matrix a = m.Transpose() * m;
+  for (int i = 0; i < n; i++) a(i, i) += n;
+  S21Matrix b(n, 2);
+  for (int i = 0; i < n; i++) {
+    b(i, 0) = i;
+    b(i, 1) = 1;
+  }
+  S21Cholesky cholesky(a);
+  EXPECT_NEAR(cholesky.Determinant() / a.Determinant(), 1, 1e-12);
+  EXPECT_TRUE(a * cholesky.Solve(b) == b);
+  EXPECT_TRUE(cholesky.Solve(b) == S21LU(a).Solve(b));
+  EXPECT_TRUE(cholesky.Inverse() == a.InverseMatrix());
+
+  S21MatrixF small(2, 2);
+  small(0, 0) = 4;
+  small(0, 1) = small(1, 0) = 2;
+  small(1, 1) = 3;
+  EXPECT_FLOAT_EQ(S21BasicCholesky<float>(small).Determinant(), 8);
+
+  S21Matrix asymmetric = a;
+  asymmetric(0, 1) += 1;
+  EXPECT_THROW(S21Cholesky{asymmetric}, std::invalid_argument);
+  S21Matrix indefinite = a;
+  indefinite(2, 2) = -1;
+  EXPECT_THROW(S21Cholesky{indefinite}, std::invalid_argument);
+}
+
+TEST(Decomposition, Qr) {
+  const int m = 9, n = 4;
+  S21Matrix a(m, n);
+  S21Matrix b(m, 2);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) a(i, j) = ((i + 1) * (j + 2)) % 5 + (i == j);
+    b(i, 0) = i * i;
+    b(i, 1) = 3 - i;
+  }
+  S21QR qr(a);
+  EXPECT_TRUE(qr.IsFullRank());
+  EXPECT_EQ(qr.GetRows(), m);
+  EXPECT_EQ(qr.GetCols(), n);
+  EXPECT_EQ(qr.Determinant(), 0);
+  // Наименьшие квадраты: невязка ортогональна столбцам A.
+  S21Matrix at = a.Transpose();
+  S21Matrix x = qr.Solve(b);
+  EXPECT_EQ(x.GetRows(), n);
+  S21Matrix residual = a * x - b;
+  EXPECT_TRUE(at * residual == S21Matrix(n, 2));
+  EXPECT_TRUE(qr.Inverse() * b == x);
+  S21Matrix normal = at * a;
+  EXPECT_TRUE(S21LU(normal).Solve(at * b) == x);
+
+  S21Matrix square(m, m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) square(i, j) = (i * 7 + j * 3) % 11 - 5;
+    square(i, i) += 10;
+  }
+  S21QR square_qr(square);
+  EXPECT_NEAR(square_qr.Determinant() / square.Determinant(), 1, 1e-9);
+  EXPECT_TRUE(square_qr.Inverse() == square.InverseMatrix());
+
+  for (int i = 0; i < m; i++) a(i, 3) = a(i, 0) - a(i, 1);
+  S21QR deficient(a);
+  EXPECT_FALSE(deficient.IsFullRank());
+  EXPECT_THROW(deficient.Solve(b), std::invalid_argument);
+  EXPECT_THROW(S21QR(S21Matrix(2, 3)), std::invalid_argument);
+}
+
+TEST(Solve, MultipleRhs) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 2;
+  a(0, 1) = 1;
+  a(0, 2) = -1;
+  a(1, 0) = -3;
+  a(1, 1) = -1;
+  a(1, 2) = 2;
+  a(2, 0) = -2;
+  a(2, 1) = 1;
+  a(2, 2) = 2;
+  S21Matrix b(3, 2);
+  b(0, 0) = 8;
+  b(1, 0) = -11;
+  b(2, 0) = -3;
+  b(0, 1) = b(1, 1) = b(2, 1) = 1;
+  S21Matrix x = a.Solve(b);
+  EXPECT_NEAR(x(0, 0), 2, 1e-12);
+  EXPECT_NEAR(x(1, 0), 3, 1e-12);
+  EXPECT_NEAR(x(2, 0), -1, 1e-12);
+  EXPECT_TRUE(x == a.InverseMatrix() * b);
+  EXPECT_TRUE(a.Solve(b.Block(0, 1, 3, 1)) == x.Block(0, 1, 3, 1));
+
+  // Несколько полос kSolveBlock и блочные подстановки через Gemm.
+  const int n = 150, nrhs = 70;
+  S21Matrix large(n, n);
+  S21Matrix rhs(n, nrhs);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) large(i, j) = (i == j) ? n : (i * j) % 7 - 3;
+    for (int j = 0; j < nrhs; j++) rhs(i, j) = (i + 2 * j) % 9;
+  }
+  S21CountingResource counter;
+  S21Matrix source(large.View(), &counter);
+  S21Matrix solution = source.Solve(rhs);
+  EXPECT_EQ(solution.GetResource(), &counter);
+  EXPECT_TRUE(large * solution == rhs);
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1;
+  EXPECT_TRUE(large.InverseMatrix() * large == identity);
+
+  S21Matrix singular(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) singular(i, j) = i + j;
+  }
+  try {
+    singular.Solve(b);
+    FAIL();
+  } catch (const std::invalid_argument &error) {
+    EXPECT_STREQ(error.what(), "Matrix determinant must be > 0.");
+  }
+  EXPECT_THROW(S21Matrix(3, 2).Solve(b), std::invalid_argument);
+  EXPECT_THROW(a.Solve(S21Matrix(4, 1)), std::invalid_argument);
+}
+
+TEST(Sparse, Conversion) {
+  S21Matrix dense(4, 5);
+  dense(0, 1) = 2;
+  dense(1, 4) = -1;
+  dense(3, 0) = 7;
+  dense(3, 3) = 0.5;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense.View(), format);
+    EXPECT_EQ(sparse.GetNonZeros(), 4);
+    EXPECT_TRUE(sparse.ToDense() == dense);
+    EXPECT_EQ(sparse(3, 3), 0.5);
+    EXPECT_EQ(sparse(2, 2), 0);
+    EXPECT_THROW(sparse(4, 0), std::out_of_range);
+    EXPECT_TRUE(sparse.Transpose().ToDense() == dense.Transpose());
+    S21SparseMatrix other = sparse.ToFormat(
+        format == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                        : S21SparseFormat::kCsr);
+    EXPECT_NE(other.GetFormat(), format);
+    EXPECT_TRUE(other.ToDense() == dense);
+  }
+  S21SparseMatrix csr(dense.View());
+  const std::ptrdiff_t offsets[] = {0, 1, 2, 2, 4};
+  const int indices[] = {1, 4, 0, 3};
+  EXPECT_TRUE(std::equal(offsets, offsets + 5, csr.GetOffsets()));
+  EXPECT_TRUE(std::equal(indices, indices + 4, csr.GetIndices()));
+
+  // Повторы складываются, сократившиеся элементы не хранятся.
+  std::vector<S21SparseEntry<double>> entries = {
+      {3, 3, 0.25}, {0, 1, 2}, {3, 0, 7}, {2, 2, 1},
+      {1, 4, -1},   {3, 3, 0.25}, {2, 2, -1}};
+  S21SparseMatrix built(4, 5, entries);
+  EXPECT_EQ(built.GetNonZeros(), 4);
+  EXPECT_TRUE(built.ToDense() == dense);
+  S21SparseMatrix built_csc(4, 5, entries, S21SparseFormat::kCsc);
+  EXPECT_TRUE(built_csc.ToDense() == dense);
+  entries.push_back({4, 0, 1});
+  EXPECT_THROW(S21SparseMatrix(4, 5, entries), std::out_of_range);
+
+  S21CountingResource counter;
+  S21SparseMatrix counted(dense.View(), S21SparseFormat::kCsr, &counter);
+  EXPECT_EQ(S21SparseMatrix(counted).GetResource(), &counter);
+  EXPECT_EQ(counted.ToDense().GetResource(), &counter);
+}
+
+TEST(Sparse, Arithmetic) {
+  S21Matrix a(6, 5);
+  S21Matrix b(6, 5);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 5; j++) {
+      if ((i + j) % 3 == 0) a(i, j) = i - j + 0.5;
+      if ((i * j) % 4 == 1) b(i, j) = j - 2;
+    }
+  }
+  S21SparseMatrix sa(a.View());
+  S21SparseMatrix sb(b.View(), S21SparseFormat::kCsc);
+  EXPECT_TRUE((sa + sb).ToDense() == a + b);
+  EXPECT_TRUE((sb - sa).ToDense() == b - a);
+  EXPECT_TRUE((sa * 3.0).ToDense() == a * 3.0);
+  S21SparseMatrix zero = sa;
+  zero -= sa;
+  EXPECT_EQ(zero.GetNonZeros(), 0);
+  EXPECT_THROW(sa += sa.Transpose(), std::invalid_argument);
+  zero = sb * 0.0;
+  EXPECT_EQ(zero.GetNonZeros(), 0);
+  EXPECT_TRUE(zero.ToDense() == S21Matrix(6, 5));
+  // Исчезновение порядка тоже удаляет элементы.
+  S21SparseMatrix tiny(sa * 1e-300);
+  tiny.MulNumber(1e-300);
+  EXPECT_EQ(tiny.GetNonZeros(), 0);
+  EXPECT_EQ(tiny.GetOffsets()[tiny.GetRows()], 0);
+
+  S21Matrix x(5, 3);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 3; j++) x(i, j) = i * 3 + j;
+  }
+  EXPECT_TRUE(sa * x == a * x);
+  EXPECT_TRUE(sb * x == b * x);
+  EXPECT_TRUE(sa.MulMatrix(x.Block(0, 2, 5, 1)) ==
+              a * S21Matrix(x.Block(0, 2, 5, 1)));
+  EXPECT_THROW(sa * a, std::invalid_argument);
+}
+
+TEST(Sparse, LargeGraph) {
+  // Кольцо из 100000 вершин с хордами: плотная матрица заняла бы 80 ГБ.
+  const int n = 100000;
+  std::vector<S21SparseEntry<double>> edges;
+  for (int i = 0; i < n; i++) {
+    edges.push_back({i, (i + 1) % n, 1});
+    edges.push_back({(i + 1) % n, i, 1});
+    if (i % 10 == 0) edges.push_back({i, (i * 7) % n, 2});
+  }
+  S21SparseMatrix adjacency(n, n, edges);
+  S21Matrix ones(n, 2);
+  for (int i = 0; i < n; i++) {
+    ones(i, 0) = 1;
+    ones(i, 1) = i;
+  }
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  const int threads = pool.GetThreadCount();
+  pool.SetThreadCount(4);
+  S21Matrix degrees = adjacency * ones;
+  pool.SetThreadCount(1);
+  EXPECT_TRUE(degrees == adjacency * ones);
+  pool.SetThreadCount(threads);
+  EXPECT_TRUE(degrees == adjacency.ToFormat(S21SparseFormat::kCsc) * ones);
+  EXPECT_EQ(degrees(1, 0), 2);
+  EXPECT_EQ(degrees(10, 0), 4);
+  EXPECT_EQ(degrees(10, 1), 9 + 11 + 2 * 70);
+}
+
+TEST(Structured, Band) {
+  const int n = 9;
+  S21Matrix dense(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 1); j++) {
+      dense(i, j) = (i * 3 + j * 5) % 7 - 3 + (i == j);
+    }
+  }
+  S21BandMatrix band(dense.View(), 2, 1);
+  EXPECT_TRUE(band.ToDense() == dense);
+  const S21BandMatrix &readonly = band;
+  EXPECT_EQ(readonly(0, 8), 0);
+  EXPECT_THROW(band(0, 8) = 1, std::out_of_range);
+  EXPECT_NEAR(band.Determinant(), dense.Determinant(), 1e-9);
+  EXPECT_TRUE(band.InverseMatrix() == dense.InverseMatrix());
+  S21Matrix b(n, 2);
+  for (int i = 0; i < n; i++) {
+    b(i, 0) = i;
+    b(i, 1) = 1;
+  }
+  EXPECT_TRUE(band.Solve(b) == dense.Solve(b));
+  EXPECT_TRUE(band.MulMatrix(b) == dense * b);
+  EXPECT_TRUE(band.Transpose().ToDense() == dense.Transpose());
+
+  // Сумма с более широкой лентой расширяет ленту.
+  S21BandMatrix tridiagonal(n, 1, 1);
+  for (int i = 0; i < n; i++) {
+    tridiagonal(i, i) = 4;
+    if (i > 0) tridiagonal(i, i - 1) = -1;
+    if (i + 1 < n) tridiagonal(i, i + 1) = -1;
+  }
+  S21BandMatrix sum = band;
+  sum.SumMatrix(tridiagonal);
+  EXPECT_EQ(sum.GetLower(), 2);
+  EXPECT_EQ(sum.GetUpper(), 1);
+  EXPECT_TRUE(sum.ToDense() == dense + tridiagonal.ToDense());
+  sum.SubMatrix(band);
+  sum.MulNumber(2);
+  EXPECT_TRUE(sum.ToDense() == tridiagonal.ToDense() * 2.0);
+
+  // Трёхдиагональная система на миллион неизвестных за O(n).
+  const int large = 1000000;
+  S21BandMatrix poisson(large, 1, 1);
+  S21Matrix ones(large, 1);
+  for (int i = 0; i < large; i++) {
+    poisson(i, i) = 2;
+    if (i > 0) poisson(i, i - 1) = -1;
+    if (i + 1 < large) poisson(i, i + 1) = -1;
+    ones(i, 0) = (i == 0 || i == large - 1) ? 1 : 0;
+  }
+  S21Matrix solution = poisson.Solve(ones);
+  EXPECT_NEAR(solution(0, 0), 1, 1e-6);
+  EXPECT_NEAR(solution(large / 2, 0), 1, 1e-6);
+
+  S21BandMatrix singular(3, 1, 0);
+  singular(0, 0) = singular(2, 2) = 1;
+  EXPECT_EQ(singular.Determinant(), 0);
+  EXPECT_THROW(singular.Solve(b.Block(0, 0, 3, 1)), std::invalid_argument);
+  EXPECT_THROW(S21BandMatrix(3, 3, 0), std::invalid_argument);
+}
+
+TEST(Structured, Triangular) {
+  const int n = 6;
+  S21Matrix dense(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) dense(i, j) = (i * 2 + j * 3) % 5 + (i == j);
+  }
+  S21Matrix b(n, 3);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < 3; j++) b(i, j) = i - j;
+  }
+  for (S21Triangle kind : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21Matrix a = kind == S21Triangle::kLower ? dense : dense.Transpose();
+    S21TriangularMatrix triangular(a.View(), kind);
+    EXPECT_TRUE(triangular.ToDense() == a);
+    EXPECT_NEAR(triangular.Determinant(), a.Determinant(), 1e-9);
+    S21TriangularMatrix inverse = triangular.InverseMatrix();
+    EXPECT_EQ(inverse.GetTriangle(), kind);
+    EXPECT_TRUE(inverse.ToDense() == a.InverseMatrix());
+    EXPECT_TRUE(triangular.Solve(b) == a.Solve(b));
+    EXPECT_TRUE(triangular.MulMatrix(b) == a * b);
+    EXPECT_TRUE(triangular.Transpose().ToDense() == a.Transpose());
+    S21TriangularMatrix twice = triangular;
+    twice.SumMatrix(triangular);
+    EXPECT_TRUE(twice.ToDense() == a * 2.0);
+    EXPECT_THROW(twice.SumMatrix(triangular.Transpose()),
+                 std::invalid_argument);
+  }
+  S21TriangularMatrix lower(dense.View(), S21Triangle::kLower);
+  EXPECT_THROW(lower(0, 1) = 1, std::out_of_range);
+  lower(3, 3) = 0;
+  EXPECT_EQ(lower.Determinant(), 0);
+  EXPECT_THROW(lower.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(lower.Solve(b), std::invalid_argument);
+}
+
+TEST(Structured, Symmetric) {
+  const int n = 5;
+  S21Matrix dense(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      dense(i, j) = dense(j, i) = (i * 3 + j) % 4 - 1.5 + 3 * (i == j);
+    }
+  }
+  S21SymmetricMatrix symmetric(dense.View());
+  EXPECT_TRUE(symmetric.ToDense() == dense);
+  EXPECT_EQ(symmetric(1, 3), symmetric(3, 1));
+  symmetric(1, 3) += 1;
+  EXPECT_EQ(symmetric(3, 1), dense(3, 1) + 1);
+  symmetric(3, 1) -= 1;
+  EXPECT_NEAR(symmetric.Determinant(), dense.Determinant(), 1e-9);
+  EXPECT_TRUE(symmetric.InverseMatrix().ToDense() == dense.InverseMatrix());
+  S21Matrix b(n, 2);
+  for (int i = 0; i < n; i++) {
+    b(i, 0) = i;
+    b(i, 1) = -2;
+  }
+  EXPECT_TRUE(symmetric.MulMatrix(b) == dense * b);
+  EXPECT_TRUE(symmetric.Solve(b) == dense.Solve(b));
+  S21SymmetricMatrix sum = symmetric;
+  sum.SumMatrix(symmetric.Transpose());
+  sum.MulNumber(0.5);
+  EXPECT_TRUE(sum.ToDense() == dense);
+  EXPECT_THROW(S21SymmetricMatrix(S21Matrix(2, 3).View()),
+               std::invalid_argument);
+
+  // Знаконеопределённые матрицы с нулевой диагональю требуют блоков 2x2;
+  // n = 150 больше полосы обращения.
+  for (int size : {2, 7, 150}) {
+    S21Matrix indefinite(size, size);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < i; j++) {
+        indefinite(i, j) = indefinite(j, i) = std::sin(i * 7 + j * 3) + 0.1;
+      }
+    }
+    S21SymmetricMatrix packed(indefinite.View());
+    S21Matrix rhs(size, 3);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < 3; j++) rhs(i, j) = i - j;
+    }
+    const double det = indefinite.Determinant();
+    EXPECT_NEAR(packed.Determinant(), det, 1e-9 * std::fabs(det));
+    S21Matrix solution = packed.Solve(rhs);
+    EXPECT_TRUE(indefinite * solution == rhs);
+    S21Matrix inverse = packed.InverseMatrix().ToDense();
+    S21Matrix identity(size, size);
+    for (int i = 0; i < size; i++) identity(i, i) = 1;
+    EXPECT_TRUE(indefinite * inverse == identity);
+  }
+  S21SymmetricMatrix singular(3);
+  singular(0, 1) = 1;
+  singular(1, 1) = 2;
+  EXPECT_DOUBLE_EQ(singular.Determinant(), 0);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(singular.Solve(b.Block(0, 0, 3, 2)), std::invalid_argument);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,135 @@
+#ifndef S21_MATRIX_VIEW_H_
+#define S21_MATRIX_VIEW_H_
+
+// Невладеющее представление прямоугольного блока матрицы только для
+// чтения: указатель на первый элемент, размеры и шаги между соседними
+// строками и столбцами в элементах. Блок, строка или столбец матрицы
+// получаются без копирования, а EqMatrix, Determinant, Transpose и
+// умножение работают прямо по исходному буферу. Представление не продлевает
+// жизнь матрицы и становится недействительным после её перевыделения
+// (SetRows/SetCols за пределами ёмкости, присваивание, разрушение).
+//
+// Представление может описывать и чужой буфер, в том числе хранящийся по
+// столбцам (column-major, как массивы Fortran и numpy с order='F').
+
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+
+template <typename T>
+class S21BasicMatrix;
+
+// Порядок хранения внешнего буфера.
+enum class S21Layout { kRowMajor, kColMajor };
+
+// Брать множитель как есть или транспонированным (S21BasicMatrix::MulAdd).
+enum class S21Transpose { kNone, kTranspose };
+
+template <typename T>
+class S21BasicMatrixView {
+ public:
+  using value_type = T;
+
+  S21BasicMatrixView() noexcept = default;
+  // stride - расстояние между началами соседних строк (kRowMajor) или
+  // столбцов (kColMajor) в элементах.
+  S21BasicMatrixView(const T* data, int rows, int cols, int stride,
+                     S21Layout layout = S21Layout::kRowMajor)
+      : data_(data), rows_(rows), cols_(cols) {
+    if (rows < 0 || cols < 0 ||
+        stride < (layout == S21Layout::kRowMajor ? cols : rows)) {
+      throw std::invalid_argument("Invalid view layout");
+    }
+    if (layout == S21Layout::kRowMajor) {
+      stride_ = stride;
+    } else {
+      stride_ = 1;
+      col_stride_ = stride;
+    }
+  }
+  // Неявное преобразование: матрицу можно передать туда, где ждут view.
+  S21BasicMatrixView(const S21BasicMatrix<T>& matrix) noexcept
+      : S21BasicMatrixView(matrix.View()) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int GetStride() const noexcept { return stride_; }
+  int GetColStride() const noexcept { return col_stride_; }
+  const T* Data() const noexcept { return data_; }
+  // Строки лежат подряд, и Row(i) применим.
+  bool IsRowMajor() const noexcept { return col_stride_ == 1; }
+  const T* Row(int i) const noexcept {
+    return data_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  T At(int i, int j) const noexcept {
+    return data_[static_cast<std::ptrdiff_t>(i) * stride_ +
+                 static_cast<std::ptrdiff_t>(j) * col_stride_];
+  }
+
+  T operator()(int i, int j) const {
+    if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+      throw std::out_of_range("Index is out of the matrix range");
+    }
+    return At(i, j);
+  }
+
+  // Блок rows x cols с левым верхним углом (row, col).
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::out_of_range("Block is out of the matrix range");
+    }
+    S21BasicMatrixView block;
+    block.data_ = data_ + static_cast<std::ptrdiff_t>(row) * stride_ +
+                  static_cast<std::ptrdiff_t>(col) * col_stride_;
+    block.rows_ = rows;
+    block.cols_ = cols;
+    block.stride_ = stride_;
+    block.col_stride_ = col_stride_;
+    return block;
+  }
+  S21BasicMatrixView RowView(int i) const { return Block(i, 0, 1, cols_); }
+  S21BasicMatrixView ColView(int j) const { return Block(0, j, rows_, 1); }
+
+  bool EqMatrix(const S21BasicMatrixView& other) const;
+  T Determinant() const;
+  S21BasicMatrix<T> Transpose() const;
+
+  // Операторы - скрытые друзья, поэтому принимают и матрицу, и view
+  // в любом сочетании.
+  friend bool operator==(const S21BasicMatrixView& lhs,
+                         const S21BasicMatrixView& rhs) {
+    return lhs.EqMatrix(rhs);
+  }
+  // Как и MulMatrix, при несогласованных размерах результат равен lhs.
+  friend S21BasicMatrix<T> operator*(const S21BasicMatrixView& lhs,
+                                     const S21BasicMatrixView& rhs) {
+    return lhs.Multiply(rhs);
+  }
+
+ private:
+  friend class S21BasicMatrix<T>;
+
+  S21BasicMatrix<T> Multiply(const S21BasicMatrixView& other) const;
+  // Временные буферы и результат берутся из resource.
+  T DeterminantWith(std::pmr::memory_resource* resource) const;
+  S21BasicMatrix<T> TransposeWith(std::pmr::memory_resource* resource) const;
+  S21BasicMatrix<T> MultiplyWith(const S21BasicMatrixView& other,
+                                 std::pmr::memory_resource* resource) const;
+
+  const T* data_ = nullptr;
+  int rows_ = 0;
+  int cols_ = 0;
+  int stride_ = 0;
+  int col_stride_ = 1;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21MatrixViewF = S21BasicMatrixView<float>;
+using S21MatrixViewLD = S21BasicMatrixView<long double>;
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+#endif  // S21_MATRIX_VIEW_H_
@@ -0,0 +1,54 @@
+#include "s21_memory_resource.h"
+
+S21CountingResource::S21CountingResource(
+    std::pmr::memory_resource* upstream) noexcept
+    : upstream_(upstream) {}
+
+std::pmr::memory_resource* S21CountingResource::GetUpstream() const noexcept {
+  return upstream_;
+}
+
+std::size_t S21CountingResource::GetAllocations() const noexcept {
+  return allocations_.load();
+}
+
+std::size_t S21CountingResource::GetDeallocations() const noexcept {
+  return deallocations_.load();
+}
+
+std::size_t S21CountingResource::GetBytesInUse() const noexcept {
+  return bytes_in_use_.load();
+}
+
+std::size_t S21CountingResource::GetPeakBytes() const noexcept {
+  return peak_bytes_.load();
+}
+
+void S21CountingResource::ResetCounters() noexcept {
+  allocations_ = 0;
+  deallocations_ = 0;
+  peak_bytes_ = bytes_in_use_.load();
+}
+
+void* S21CountingResource::do_allocate(std::size_t bytes,
+                                       std::size_t alignment) {
+  void* p = upstream_->allocate(bytes, alignment);
+  ++allocations_;
+  std::size_t in_use = bytes_in_use_ += bytes;
+  std::size_t peak = peak_bytes_.load();
+  while (in_use > peak && !peak_bytes_.compare_exchange_weak(peak, in_use)) {
+  }
+  return p;
+}
+
+void S21CountingResource::do_deallocate(void* p, std::size_t bytes,
+                                        std::size_t alignment) {
+  upstream_->deallocate(p, bytes, alignment);
+  ++deallocations_;
+  bytes_in_use_ -= bytes;
+}
+
+bool S21CountingResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
@@ -0,0 +1,40 @@
+#ifndef S21_MEMORY_RESOURCE_H_
+#define S21_MEMORY_RESOURCE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+// Ресурс памяти, который считает выделения и передаёт их вышестоящему
+// ресурсу (по умолчанию - std::pmr::new_delete_resource()). Оборачивает,
+// например, std::pmr::monotonic_buffer_resource, чтобы проверить, сколько
+// буферов матриц выделено из арены и все ли освобождены.
+class S21CountingResource : public std::pmr::memory_resource {
+ public:
+  explicit S21CountingResource(
+      std::pmr::memory_resource* upstream =
+          std::pmr::new_delete_resource()) noexcept;
+
+  std::pmr::memory_resource* GetUpstream() const noexcept;
+  std::size_t GetAllocations() const noexcept;
+  std::size_t GetDeallocations() const noexcept;
+  // Байты, выделенные и ещё не освобождённые, и их максимум.
+  std::size_t GetBytesInUse() const noexcept;
+  std::size_t GetPeakBytes() const noexcept;
+  void ResetCounters() noexcept;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+
+  std::pmr::memory_resource* upstream_;
+  std::atomic<std::size_t> allocations_{0};
+  std::atomic<std::size_t> deallocations_{0};
+  std::atomic<std::size_t> bytes_in_use_{0};
+  std::atomic<std::size_t> peak_bytes_{0};
+};
+
+#endif  // S21_MEMORY_RESOURCE_H_
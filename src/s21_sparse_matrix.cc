@@ -0,0 +1,395 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Переставляет сжатый формат в противоположный (CSR <-> CSC) подсчётом:
+// элементы обходятся по порядку старших индексов, поэтому младшие индексы
+// результата в каждой строке (столбце) сразу отсортированы.
+template <typename T>
+void Transposed(int major, int minor, const std::ptrdiff_t *offsets,
+                const int *indices, const T *values,
+                std::pmr::vector<std::ptrdiff_t> &out_offsets,
+                std::pmr::vector<int> &out_indices,
+                std::pmr::vector<T> &out_values) {
+  const std::ptrdiff_t nnz = offsets[major];
+  out_offsets.assign(minor + 1, 0);
+  out_indices.resize(nnz);
+  out_values.resize(nnz);
+  for (std::ptrdiff_t p = 0; p < nnz; ++p) ++out_offsets[indices[p] + 1];
+  for (int i = 0; i < minor; ++i) out_offsets[i + 1] += out_offsets[i];
+  std::pmr::vector<std::ptrdiff_t> next(out_offsets.begin(),
+                                        out_offsets.end() - 1,
+                                        out_offsets.get_allocator());
+  for (int i = 0; i < major; ++i) {
+    for (std::ptrdiff_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+      const std::ptrdiff_t q = next[indices[p]]++;
+      out_indices[q] = i;
+      out_values[q] = values[p];
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : S21BasicSparseMatrix(std::pmr::get_default_resource()) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    std::pmr::memory_resource *resource)
+    : offsets_(1, 0, resource), indices_(resource), values_(resource) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, S21SparseFormat format,
+    std::pmr::memory_resource *resource)
+    : S21BasicSparseMatrix(resource != nullptr
+                               ? resource
+                               : std::pmr::get_default_resource()) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Invalid sparse matrix size " +
+                                std::to_string(rows) + "x" +
+                                std::to_string(cols));
+  }
+  rows_ = rows;
+  cols_ = cols;
+  format_ = format;
+  offsets_.assign(Major() + 1, 0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<S21SparseEntry<T>> &entries,
+    S21SparseFormat format, std::pmr::memory_resource *resource)
+    : S21BasicSparseMatrix(rows, cols, format, resource) {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (const S21SparseEntry<T> &entry : entries) {
+    if (entry.row < 0 || entry.row >= rows_ || entry.col < 0 ||
+        entry.col >= cols_) {
+      throw std::out_of_range("Index is out of the matrix range");
+    }
+  }
+  // Сначала элементы раскладываются по младшему индексу, затем по
+  // старшему в этом порядке: внутри строки (столбца) младшие индексы
+  // оказываются по возрастанию, а повторы - рядом.
+  const int major = Major();
+  const int minor = Minor();
+  const std::ptrdiff_t count = entries.size();
+  std::pmr::vector<std::ptrdiff_t> by_minor(minor + 1, 0, GetResource());
+  for (const S21SparseEntry<T> &entry : entries) {
+    ++by_minor[(csr ? entry.col : entry.row) + 1];
+  }
+  for (int i = 0; i < minor; ++i) by_minor[i + 1] += by_minor[i];
+  std::pmr::vector<std::ptrdiff_t> order(count, GetResource());
+  for (std::ptrdiff_t p = 0; p < count; ++p) {
+    const S21SparseEntry<T> &entry = entries[p];
+    order[by_minor[csr ? entry.col : entry.row]++] = p;
+  }
+  for (const S21SparseEntry<T> &entry : entries) {
+    ++offsets_[(csr ? entry.row : entry.col) + 1];
+  }
+  for (int i = 0; i < major; ++i) offsets_[i + 1] += offsets_[i];
+  indices_.resize(count);
+  values_.resize(count);
+  std::pmr::vector<std::ptrdiff_t> next(offsets_.begin(), offsets_.end() - 1,
+                                        GetResource());
+  for (std::ptrdiff_t p : order) {
+    const S21SparseEntry<T> &entry = entries[p];
+    const std::ptrdiff_t q = next[csr ? entry.row : entry.col]++;
+    indices_[q] = csr ? entry.col : entry.row;
+    values_[q] = entry.value;
+  }
+  // Повторы складываются, нули выбрасываются сдвигом на месте.
+  std::ptrdiff_t size = 0;
+  for (int i = 0; i < major; ++i) {
+    const std::ptrdiff_t begin = offsets_[i];
+    offsets_[i] = size;
+    for (std::ptrdiff_t p = begin; p < offsets_[i + 1];) {
+      const int index = indices_[p];
+      T value = values_[p++];
+      while (p < offsets_[i + 1] && indices_[p] == index) value += values_[p++];
+      if (value != T(0)) {
+        indices_[size] = index;
+        values_[size++] = value;
+      }
+    }
+  }
+  offsets_[major] = size;
+  indices_.resize(size);
+  values_.resize(size);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicMatrixView<T> &dense, S21SparseFormat format,
+    std::pmr::memory_resource *resource)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols(), format,
+                           resource) {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int i = 0; i < Major(); ++i) {
+    for (int j = 0; j < Minor(); ++j) {
+      const T value = csr ? dense.At(i, j) : dense.At(j, i);
+      if (value != T(0)) {
+        indices_.push_back(j);
+        values_.push_back(value);
+      }
+    }
+    offsets_[i + 1] = values_.size();
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicSparseMatrix &other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      format_(other.format_),
+      offsets_(other.offsets_, other.GetResource()),
+      indices_(other.indices_, other.GetResource()),
+      values_(other.values_, other.GetResource()) {}
+
+// Операции над матрицами:
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_, GetResource());
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int i = 0; i < Major(); ++i) {
+    for (std::ptrdiff_t p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      if (csr) {
+        result.Row(i)[indices_[p]] = values_[p];
+      } else {
+        result.Row(indices_[p])[i] = values_[p];
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) return *this;
+  S21BasicSparseMatrix result(rows_, cols_, format, GetResource());
+  Transposed(Major(), Minor(), offsets_.data(), indices_.data(),
+             values_.data(), result.offsets_, result.indices_,
+             result.values_);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                                     : S21SparseFormat::kCsr;
+  return result;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix &other) {
+  Merge(other, T(1));
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix &other) {
+  Merge(other, T(-1));
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulNumber(T num) noexcept {
+  if (num == T(0)) {
+    indices_.clear();
+    values_.clear();
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    return;
+  }
+  // Произведение может обратиться в ноль и при num != 0 (исчезновение
+  // порядка): такие элементы удаляются, как в Merge.
+  std::ptrdiff_t count = 0;
+  std::ptrdiff_t begin = 0;
+  for (int i = 0; i < Major(); ++i) {
+    const std::ptrdiff_t end = offsets_[i + 1];
+    for (std::ptrdiff_t p = begin; p < end; ++p) {
+      const T value = values_[p] * num;
+      if (value != T(0)) {
+        indices_[count] = indices_[p];
+        values_[count++] = value;
+      }
+    }
+    begin = end;
+    offsets_[i + 1] = count;
+  }
+  indices_.resize(count);
+  values_.resize(count);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulMatrix(
+    const S21BasicMatrixView<T> &dense) const {
+  if (dense.GetRows() != cols_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (!dense.IsRowMajor()) {
+    return MulMatrix(S21BasicMatrix<T>(dense, GetResource()));
+  }
+  const int k = dense.GetCols();
+  S21BasicMatrix<T> result(rows_, k, GetResource());
+  if (format_ == S21SparseFormat::kCsc) {
+    // Столбец j матрицы A добавляет a_ij * x_j к строкам i результата.
+    for (int j = 0; j < cols_; ++j) {
+      const T *x_j = dense.Row(j);
+      for (std::ptrdiff_t p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+        T *y_i = result.Row(indices_[p]);
+        const T a = values_[p];
+        for (int c = 0; c < k; ++c) y_i[c] += a * x_j[c];
+      }
+    }
+    return result;
+  }
+  auto rows = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      T *y_i = result.Row(i);
+      for (std::ptrdiff_t p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+        const T *x_j = dense.Row(indices_[p]);
+        const T a = values_[p];
+        for (int c = 0; c < k; ++c) y_i[c] += a * x_j[c];
+      }
+    }
+  };
+  const std::ptrdiff_t nnz = GetNonZeros();
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  if (nnz * k < kParallelSize || pool.GetThreadCount() == 1) {
+    rows(0, rows_);
+    return result;
+  }
+  // Полосы строк с равным числом ненулевых элементов, по несколько на
+  // поток: степени вершин графов сильно неравномерны.
+  const int tasks = std::min(rows_, 4 * pool.GetThreadCount());
+  auto boundary = [&](int t) {
+    const std::ptrdiff_t target = nnz * t / tasks;
+    return static_cast<int>(
+        std::lower_bound(offsets_.begin(), offsets_.end(), target) -
+        offsets_.begin());
+  };
+  pool.ParallelFor(tasks, [&](int t) {
+    rows(boundary(t), t + 1 == tasks ? rows_ : boundary(t + 1));
+  });
+  return result;
+}
+
+// Операторы :
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix &other) const {
+  S21BasicSparseMatrix result(*this);
+  result.Merge(other, T(1));
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix &other) const {
+  S21BasicSparseMatrix result(*this);
+  result.Merge(other, T(-1));
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator+=(
+    const S21BasicSparseMatrix &other) {
+  Merge(other, T(1));
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator-=(
+    const S21BasicSparseMatrix &other) {
+  Merge(other, T(-1));
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(T num) const {
+  S21BasicSparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrixView<T> &dense) const {
+  return MulMatrix(dense);
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  if (format_ == S21SparseFormat::kCsc) std::swap(i, j);
+  const auto begin = indices_.begin() + offsets_[i];
+  const auto end = indices_.begin() + offsets_[i + 1];
+  const auto it = std::lower_bound(begin, end, j);
+  return it != end && *it == j ? values_[it - indices_.begin()] : T(0);
+}
+
+// Доп. функции:
+
+// this += sign * other слиянием отсортированных строк (столбцов) в новые
+// массивы.
+template <typename T>
+void S21BasicSparseMatrix<T>::Merge(const S21BasicSparseMatrix &other,
+                                    T sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (other.format_ != format_) {
+    Merge(other.ToFormat(format_), sign);
+    return;
+  }
+  std::pmr::vector<std::ptrdiff_t> offsets(Major() + 1, 0, GetResource());
+  std::pmr::vector<int> indices(GetResource());
+  std::pmr::vector<T> values(GetResource());
+  indices.reserve(indices_.size() + other.indices_.size());
+  values.reserve(values_.size() + other.values_.size());
+  for (int i = 0; i < Major(); ++i) {
+    std::ptrdiff_t p = offsets_[i], q = other.offsets_[i];
+    const std::ptrdiff_t p_end = offsets_[i + 1];
+    const std::ptrdiff_t q_end = other.offsets_[i + 1];
+    while (p < p_end || q < q_end) {
+      int index;
+      T value;
+      if (q == q_end || (p < p_end && indices_[p] < other.indices_[q])) {
+        index = indices_[p];
+        value = values_[p++];
+      } else if (p == p_end || other.indices_[q] < indices_[p]) {
+        index = other.indices_[q];
+        value = sign * other.values_[q++];
+      } else {
+        index = indices_[p];
+        value = values_[p++] + sign * other.values_[q++];
+      }
+      if (value != T(0)) {
+        indices.push_back(index);
+        values.push_back(value);
+      }
+    }
+    offsets[i + 1] = values.size();
+  }
+  offsets_.swap(offsets);
+  indices_.swap(indices);
+  values_.swap(values);
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
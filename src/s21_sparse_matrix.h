@@ -0,0 +1,130 @@
+#ifndef S21_SPARSE_MATRIX_H_
+#define S21_SPARSE_MATRIX_H_
+
+// Разреженная матрица в сжатом формате: по строкам (CSR) или по столбцам
+// (CSC). Хранятся только ненулевые элементы, поэтому память и время
+// операций пропорциональны их числу, а не rows * cols: матрица смежности
+// графа 100000 x 100000 с десятком рёбер на вершину занимает мегабайты.
+//
+// Шаблон определён в s21_sparse_matrix.cc и инстанцирован для float,
+// double и long double.
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Направление сжатия.
+enum class S21SparseFormat { kCsr, kCsc };
+
+// Элемент для построения разреженной матрицы.
+template <typename T>
+struct S21SparseEntry {
+  int row;
+  int col;
+  T value;
+};
+
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using value_type = T;
+
+  // Начиная с этого объёма (ненулевые элементы * столбцы плотного
+  // множителя) умножение CSR делит строки между потоками S21ThreadPool.
+  static constexpr std::ptrdiff_t kParallelSize = 1 << 15;
+
+  //// Конструкторы:
+  S21BasicSparseMatrix();
+  explicit S21BasicSparseMatrix(std::pmr::memory_resource* resource);
+  // Нулевая матрица rows x cols; nullptr - ресурс по умолчанию.
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr,
+                       std::pmr::memory_resource* resource = nullptr);
+  // Элементы в любом порядке; значения с одинаковыми (row, col)
+  // складываются, нули не хранятся.
+  S21BasicSparseMatrix(int rows, int cols,
+                       const std::vector<S21SparseEntry<T>>& entries,
+                       S21SparseFormat format = S21SparseFormat::kCsr,
+                       std::pmr::memory_resource* resource = nullptr);
+  // Ненулевые элементы плотной матрицы.
+  explicit S21BasicSparseMatrix(
+      const S21BasicMatrixView<T>& dense,
+      S21SparseFormat format = S21SparseFormat::kCsr,
+      std::pmr::memory_resource* resource = nullptr);
+  S21BasicSparseMatrix(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix(S21BasicSparseMatrix&& other) noexcept = default;
+  S21BasicSparseMatrix& operator=(const S21BasicSparseMatrix& other) = default;
+  S21BasicSparseMatrix& operator=(S21BasicSparseMatrix&& other) = default;
+
+  // Операции над матрицами:
+  S21BasicMatrix<T> ToDense() const;
+  // Та же матрица в другом формате, O(rows + cols + nnz).
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  // A^T без перестановки элементов: CSR становится CSC с теми же
+  // массивами и наоборот.
+  S21BasicSparseMatrix Transpose() const;
+  // Размеры должны совпадать (иначе std::invalid_argument), формат other
+  // может отличаться. Сократившиеся до нуля элементы удаляются.
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  void SubMatrix(const S21BasicSparseMatrix& other);
+  void MulNumber(T num) noexcept;
+  // this * dense: SpMV для вектора-столбца и SpMM для нескольких столбцов.
+  // Для CSR строки результата считаются независимо и параллельно, для CSC
+  // столбцы A разбрасываются в результат последовательно.
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrixView<T>& dense) const;
+
+  // Операторы :
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix operator-(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix& operator+=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator-=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix operator*(T num) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& dense) const;
+  // Поиск делением пополам в строке (CSR) или столбце (CSC).
+  T operator()(int i, int j) const;
+
+  // Доп. функции:
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  std::ptrdiff_t GetNonZeros() const noexcept { return values_.size(); }
+  S21SparseFormat GetFormat() const noexcept { return format_; }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return values_.get_allocator().resource();
+  }
+  // Массивы сжатого формата для обмена с другими библиотеками: в CSR
+  // offsets[i]..offsets[i + 1] - элементы i-й строки, indices - их номера
+  // столбцов по возрастанию; в CSC роли строк и столбцов меняются.
+  const std::ptrdiff_t* GetOffsets() const noexcept { return offsets_.data(); }
+  const int* GetIndices() const noexcept { return indices_.data(); }
+  const T* GetValues() const noexcept { return values_.data(); }
+
+ private:
+  // Число строк (CSR) или столбцов (CSC) и размер по другой стороне.
+  int Major() const noexcept {
+    return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+  }
+  int Minor() const noexcept {
+    return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+  }
+  void Merge(const S21BasicSparseMatrix& other, T sign);
+
+  int rows_ = {0};
+  int cols_ = {0};
+  S21SparseFormat format_ = S21SparseFormat::kCsr;
+  // Major() + 1 начал строк (столбцов) в indices_ и values_.
+  std::pmr::vector<std::ptrdiff_t> offsets_;
+  std::pmr::vector<int> indices_;
+  std::pmr::vector<T> values_;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21SparseMatrixF = S21BasicSparseMatrix<float>;
+using S21SparseMatrixLD = S21BasicSparseMatrix<long double>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+
+#endif  // S21_SPARSE_MATRIX_H_
@@ -0,0 +1,812 @@
+#include "s21_structured_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "s21_matrix_kernels.h"
+
+namespace {
+
+void CheckSize(int n) {
+  if (n < 1) {
+    throw std::invalid_argument("Matrix size cannot be less than 1x1");
+  }
+}
+
+template <typename T>
+void CheckSquare(const S21BasicMatrixView<T> &dense) {
+  if (dense.GetRows() != dense.GetCols()) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+}
+
+}  // namespace
+
+// Ленточная матрица :
+
+template <typename T>
+S21BasicBandMatrix<T>::S21BasicBandMatrix(int n, int lower, int upper,
+                                          std::pmr::memory_resource *resource)
+    : n_(n),
+      lower_(lower),
+      upper_(upper),
+      data_(resource != nullptr ? resource : std::pmr::get_default_resource()) {
+  CheckSize(n);
+  if (lower < 0 || upper < 0 || lower >= n || upper >= n) {
+    throw std::invalid_argument("Invalid bandwidth " + std::to_string(lower) +
+                                "," + std::to_string(upper));
+  }
+  data_.assign(static_cast<std::size_t>(n) * Width(), T(0));
+}
+
+template <typename T>
+S21BasicBandMatrix<T>::S21BasicBandMatrix(const S21BasicMatrixView<T> &dense,
+                                          int lower, int upper,
+                                          std::pmr::memory_resource *resource)
+    : S21BasicBandMatrix(dense.GetRows(), lower, upper, resource) {
+  CheckSquare(dense);
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + upper_ + 1);
+    for (int j = std::max(0, i - lower_); j < end; ++j) {
+      Row(i)[j] = dense.At(i, j);
+    }
+  }
+}
+
+template <typename T>
+S21BasicBandMatrix<T>::S21BasicBandMatrix(const S21BasicBandMatrix &other)
+    : n_(other.n_),
+      lower_(other.lower_),
+      upper_(other.upper_),
+      data_(other.data_, other.GetResource()) {}
+
+template <typename T>
+void S21BasicBandMatrix<T>::SumMatrix(const S21BasicBandMatrix &other) {
+  Merge(other, T(1));
+}
+
+template <typename T>
+void S21BasicBandMatrix<T>::SubMatrix(const S21BasicBandMatrix &other) {
+  Merge(other, T(-1));
+}
+
+template <typename T>
+void S21BasicBandMatrix<T>::MulNumber(T num) noexcept {
+  s21_kernels::Scale(data_.data(), num, data_.size());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::MulMatrix(
+    const S21BasicMatrixView<T> &dense) const {
+  if (dense.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (!dense.IsRowMajor()) {
+    return MulMatrix(S21BasicMatrix<T>(dense, GetResource()));
+  }
+  const int k = dense.GetCols();
+  S21BasicMatrix<T> result(n_, k, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    T *y_i = result.Row(i);
+    const T *a_i = Row(i);
+    const int end = std::min(n_, i + upper_ + 1);
+    for (int j = std::max(0, i - lower_); j < end; ++j) {
+      const T *x_j = dense.Row(j);
+      const T a = a_i[j];
+      for (int c = 0; c < k; ++c) y_i[c] += a * x_j[c];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicBandMatrix<T> S21BasicBandMatrix<T>::Transpose() const {
+  S21BasicBandMatrix result(n_, upper_, lower_, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + upper_ + 1);
+    for (int j = std::max(0, i - lower_); j < end; ++j) {
+      result.Row(j)[i] = Row(i)[j];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicBandMatrix<T>::Determinant() const {
+  std::pmr::vector<T> lu(GetResource());
+  std::pmr::vector<int> perm(GetResource());
+  T det = Factor(lu, perm, T(0));
+  const int width = 2 * lower_ + upper_ + 1;
+  for (int k = 0; k < n_ && det != T(0); ++k) {
+    det *= lu[static_cast<std::size_t>(k) * width + lower_];
+  }
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  if (b.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  std::pmr::vector<T> lu(GetResource());
+  std::pmr::vector<int> perm(GetResource());
+  const T tolerance =
+      s21_kernels::SingularTolerance(data_.data(), n_, Width(), Width());
+  if (Factor(lu, perm, tolerance) == 0) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  S21BasicMatrix<T> x(b, GetResource());
+  const int nrhs = x.cols_;
+  const int width = 2 * lower_ + upper_ + 1;
+  // Элемент (i, j) разложения - lu[i * width + lower_ + j - i].
+  auto lu_row = [&](int i) {
+    return lu.data() + static_cast<std::ptrdiff_t>(i) * width + lower_ - i;
+  };
+  // L * Y = P * B: перестановки применяются по мере исключения.
+  for (int k = 0; k < n_; ++k) {
+    T *x_k = x.Row(k);
+    if (perm[k] != k) std::swap_ranges(x_k, x_k + nrhs, x.Row(perm[k]));
+    const int last = std::min(n_ - 1, k + lower_);
+    for (int i = k + 1; i <= last; ++i) {
+      T *x_i = x.Row(i);
+      const T factor = lu_row(i)[k];
+      for (int c = 0; c < nrhs; ++c) x_i[c] -= factor * x_k[c];
+    }
+  }
+  // U * X = Y, у U верхняя лента шириной lower_ + upper_.
+  for (int i = n_ - 1; i >= 0; --i) {
+    T *x_i = x.Row(i);
+    const T *u_i = lu_row(i);
+    const int end = std::min(n_, i + lower_ + upper_ + 1);
+    for (int j = i + 1; j < end; ++j) {
+      const T *x_j = x.Row(j);
+      const T factor = u_i[j];
+      for (int c = 0; c < nrhs; ++c) x_i[c] -= factor * x_j[c];
+    }
+    s21_kernels::Scale(x_i, T(1) / u_i[i], nrhs);
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::InverseMatrix() const {
+  S21BasicMatrix<T> identity(n_, n_, GetResource());
+  for (int i = 0; i < n_; ++i) identity.Row(i)[i] = T(1);
+  return Solve(identity);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(n_, n_, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + upper_ + 1);
+    const int begin = std::max(0, i - lower_);
+    std::copy(Row(i) + begin, Row(i) + end, result.Row(i) + begin);
+  }
+  return result;
+}
+
+template <typename T>
+T &S21BasicBandMatrix<T>::operator()(int i, int j) {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_ || j < i - lower_ ||
+      j > i + upper_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return Row(i)[j];
+}
+
+template <typename T>
+T S21BasicBandMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return j < i - lower_ || j > i + upper_ ? T(0) : Row(i)[j];
+}
+
+template <typename T>
+void S21BasicBandMatrix<T>::Widen(int lower, int upper) {
+  if (lower <= lower_ && upper <= upper_) return;
+  S21BasicBandMatrix wide(n_, std::max(lower, lower_), std::max(upper, upper_),
+                          GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + upper_ + 1);
+    const int begin = std::max(0, i - lower_);
+    std::copy(Row(i) + begin, Row(i) + end, wide.Row(i) + begin);
+  }
+  *this = std::move(wide);
+}
+
+template <typename T>
+void S21BasicBandMatrix<T>::Merge(const S21BasicBandMatrix &other, T sign) {
+  if (n_ != other.n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  Widen(other.lower_, other.upper_);
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + other.upper_ + 1);
+    const T *b_i = other.Row(i);
+    T *a_i = Row(i);
+    for (int j = std::max(0, i - other.lower_); j < end; ++j) {
+      a_i[j] += sign * b_i[j];
+    }
+  }
+}
+
+template <typename T>
+int S21BasicBandMatrix<T>::Factor(std::pmr::vector<T> &lu,
+                                  std::pmr::vector<int> &perm,
+                                  T tolerance) const {
+  // Перестановка строк сдвигает элементы U вправо не дальше чем на lower_
+  // столбцов, поэтому у каждой строки разложения есть lower_ запасных
+  // столбцов справа.
+  const int width = 2 * lower_ + upper_ + 1;
+  lu.assign(static_cast<std::size_t>(n_) * width, T(0));
+  perm.resize(n_);
+  auto lu_row = [&](int i) {
+    return lu.data() + static_cast<std::ptrdiff_t>(i) * width + lower_ - i;
+  };
+  for (int i = 0; i < n_; ++i) {
+    const int end = std::min(n_, i + upper_ + 1);
+    const int begin = std::max(0, i - lower_);
+    std::copy(Row(i) + begin, Row(i) + end, lu_row(i) + begin);
+  }
+  int sign = 1;
+  for (int k = 0; k < n_; ++k) {
+    const int last = std::min(n_ - 1, k + lower_);
+    const int end = std::min(n_, k + lower_ + upper_ + 1);
+    int pivot = k;
+    T max = std::fabs(lu_row(k)[k]);
+    for (int i = k + 1; i <= last; ++i) {
+      if (std::fabs(lu_row(i)[k]) > max) {
+        max = std::fabs(lu_row(i)[k]);
+        pivot = i;
+      }
+    }
+    if (max <= tolerance) return 0;
+    perm[k] = pivot;
+    T *row_k = lu_row(k);
+    if (pivot != k) {
+      std::swap_ranges(row_k + k, row_k + end, lu_row(pivot) + k);
+      sign = -sign;
+    }
+    for (int i = k + 1; i <= last; ++i) {
+      T *row_i = lu_row(i);
+      const T factor = row_i[k] / row_k[k];
+      row_i[k] = factor;
+      for (int j = k + 1; j < end; ++j) row_i[j] -= factor * row_k[j];
+    }
+  }
+  return sign;
+}
+
+// Треугольная матрица :
+
+template <typename T>
+S21BasicTriangularMatrix<T>::S21BasicTriangularMatrix(
+    int n, S21Triangle triangle, std::pmr::memory_resource *resource)
+    : n_(n),
+      triangle_(triangle),
+      data_(resource != nullptr ? resource : std::pmr::get_default_resource()) {
+  CheckSize(n);
+  data_.assign(static_cast<std::size_t>(n) * (n + 1) / 2, T(0));
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T>::S21BasicTriangularMatrix(
+    const S21BasicMatrixView<T> &dense, S21Triangle triangle,
+    std::pmr::memory_resource *resource)
+    : S21BasicTriangularMatrix(dense.GetRows(), triangle, resource) {
+  CheckSquare(dense);
+  for (int i = 0; i < n_; ++i) {
+    const int begin = IsLower() ? 0 : i;
+    const int end = IsLower() ? i + 1 : n_;
+    for (int j = begin; j < end; ++j) Row(i)[j] = dense.At(i, j);
+  }
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T>::S21BasicTriangularMatrix(
+    const S21BasicTriangularMatrix &other)
+    : n_(other.n_),
+      triangle_(other.triangle_),
+      data_(other.data_, other.GetResource()) {}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::SumMatrix(
+    const S21BasicTriangularMatrix &other) {
+  if (n_ != other.n_ || triangle_ != other.triangle_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  s21_kernels::Add(data_.data(), other.data_.data(), data_.size());
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::SubMatrix(
+    const S21BasicTriangularMatrix &other) {
+  if (n_ != other.n_ || triangle_ != other.triangle_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  s21_kernels::Sub(data_.data(), other.data_.data(), data_.size());
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::MulNumber(T num) noexcept {
+  s21_kernels::Scale(data_.data(), num, data_.size());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::MulMatrix(
+    const S21BasicMatrixView<T> &dense) const {
+  if (dense.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (!dense.IsRowMajor()) {
+    return MulMatrix(S21BasicMatrix<T>(dense, GetResource()));
+  }
+  const int k = dense.GetCols();
+  S21BasicMatrix<T> result(n_, k, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    T *y_i = result.Row(i);
+    const T *a_i = Row(i);
+    const int begin = IsLower() ? 0 : i;
+    const int end = IsLower() ? i + 1 : n_;
+    for (int j = begin; j < end; ++j) {
+      const T *x_j = dense.Row(j);
+      const T a = a_i[j];
+      for (int c = 0; c < k; ++c) y_i[c] += a * x_j[c];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> S21BasicTriangularMatrix<T>::Transpose() const {
+  S21BasicTriangularMatrix result(
+      n_, IsLower() ? S21Triangle::kUpper : S21Triangle::kLower,
+      GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const int begin = IsLower() ? 0 : i;
+    const int end = IsLower() ? i + 1 : n_;
+    for (int j = begin; j < end; ++j) result.Row(j)[i] = Row(i)[j];
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicTriangularMatrix<T>::Determinant() const noexcept {
+  T det = 1;
+  for (int i = 0; i < n_; ++i) det *= Row(i)[i];
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  if (b.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  CheckSingular();
+  S21BasicMatrix<T> x(b, GetResource());
+  const int nrhs = x.cols_;
+  // x_i = (b_i - sum a_ij * x_j) / a_ii по уже найденным x_j: сверху вниз
+  // для нижней матрицы и снизу вверх для верхней.
+  for (int step = 0; step < n_; ++step) {
+    const int i = IsLower() ? step : n_ - 1 - step;
+    const T *a_i = Row(i);
+    T *x_i = x.Row(i);
+    const int begin = IsLower() ? 0 : i + 1;
+    const int end = IsLower() ? i : n_;
+    for (int j = begin; j < end; ++j) {
+      const T *x_j = x.Row(j);
+      const T factor = a_i[j];
+      for (int c = 0; c < nrhs; ++c) x_i[c] -= factor * x_j[c];
+    }
+    s21_kernels::Scale(x_i, T(1) / a_i[i], nrhs);
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> S21BasicTriangularMatrix<T>::InverseMatrix()
+    const {
+  CheckSingular();
+  S21BasicTriangularMatrix result(n_, triangle_, GetResource());
+  // Строка i обратной: (e_i - sum a_ik * x_k) / a_ii по строкам x_k, уже
+  // найденным; все строки лежат внутри треугольника.
+  for (int step = 0; step < n_; ++step) {
+    const int i = IsLower() ? step : n_ - 1 - step;
+    const T *a_i = Row(i);
+    T *x_i = result.Row(i);
+    x_i[i] = T(1);
+    const int begin = IsLower() ? 0 : i + 1;
+    const int end = IsLower() ? i : n_;
+    for (int k = begin; k < end; ++k) {
+      const T *x_k = result.Row(k);
+      const T factor = a_i[k];
+      const int from = IsLower() ? 0 : k;
+      const int to = IsLower() ? k + 1 : n_;
+      for (int j = from; j < to; ++j) x_i[j] -= factor * x_k[j];
+    }
+    const int from = IsLower() ? 0 : i;
+    const int to = IsLower() ? i + 1 : n_;
+    s21_kernels::Scale(x_i + from, T(1) / a_i[i], to - from);
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(n_, n_, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const int begin = IsLower() ? 0 : i;
+    const int end = IsLower() ? i + 1 : n_;
+    std::copy(Row(i) + begin, Row(i) + end, result.Row(i) + begin);
+  }
+  return result;
+}
+
+template <typename T>
+T &S21BasicTriangularMatrix<T>::operator()(int i, int j) {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_ || !Contains(i, j)) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return Row(i)[j];
+}
+
+template <typename T>
+T S21BasicTriangularMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return Contains(i, j) ? Row(i)[j] : T(0);
+}
+
+// Нулевой элемент диагонали (с точностью до округления) - вырожденность.
+template <typename T>
+void S21BasicTriangularMatrix<T>::CheckSingular() const {
+  const T tolerance = s21_kernels::SingularTolerance(
+      data_.data(), 1, static_cast<int>(data_.size()), 0) * n_;
+  for (int i = 0; i < n_; ++i) {
+    if (std::fabs(Row(i)[i]) <= tolerance) {
+      throw std::invalid_argument("Matrix determinant must be > 0.");
+    }
+  }
+}
+
+// Симметричная матрица :
+
+template <typename T>
+S21BasicSymmetricMatrix<T>::S21BasicSymmetricMatrix(
+    int n, std::pmr::memory_resource *resource)
+    : n_(n),
+      data_(resource != nullptr ? resource : std::pmr::get_default_resource()) {
+  CheckSize(n);
+  data_.assign(static_cast<std::size_t>(n) * (n + 1) / 2, T(0));
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T>::S21BasicSymmetricMatrix(
+    const S21BasicMatrixView<T> &dense, std::pmr::memory_resource *resource)
+    : S21BasicSymmetricMatrix(dense.GetRows(), resource) {
+  CheckSquare(dense);
+  for (int i = 0; i < n_; ++i) {
+    for (int j = 0; j <= i; ++j) Row(i)[j] = dense.At(i, j);
+  }
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T>::S21BasicSymmetricMatrix(
+    const S21BasicSymmetricMatrix &other)
+    : n_(other.n_), data_(other.data_, other.GetResource()) {}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::SumMatrix(
+    const S21BasicSymmetricMatrix &other) {
+  if (n_ != other.n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  s21_kernels::Add(data_.data(), other.data_.data(), data_.size());
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::SubMatrix(
+    const S21BasicSymmetricMatrix &other) {
+  if (n_ != other.n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  s21_kernels::Sub(data_.data(), other.data_.data(), data_.size());
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::MulNumber(T num) noexcept {
+  s21_kernels::Scale(data_.data(), num, data_.size());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::MulMatrix(
+    const S21BasicMatrixView<T> &dense) const {
+  if (dense.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  if (!dense.IsRowMajor()) {
+    return MulMatrix(S21BasicMatrix<T>(dense, GetResource()));
+  }
+  const int k = dense.GetCols();
+  S21BasicMatrix<T> result(n_, k, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    const T *a_i = Row(i);
+    const T *x_i = dense.Row(i);
+    T *y_i = result.Row(i);
+    for (int j = 0; j < i; ++j) {
+      const T a = a_i[j];
+      const T *x_j = dense.Row(j);
+      T *y_j = result.Row(j);
+      for (int c = 0; c < k; ++c) {
+        y_i[c] += a * x_j[c];
+        y_j[c] += a * x_i[c];
+      }
+    }
+    const T diagonal = a_i[i];
+    for (int c = 0; c < k; ++c) y_i[c] += diagonal * x_i[c];
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicSymmetricMatrix<T>::Determinant() const {
+  std::pmr::vector<T> ldl(GetResource());
+  std::pmr::vector<int> pivots(GetResource());
+  if (!Factor(ldl, pivots, T(0))) return T(0);
+  // Симметричные перестановки не меняют определитель: det A = det D.
+  auto at = [&](int i, int j) {
+    return ldl[static_cast<std::size_t>(i) * (i + 1) / 2 + j];
+  };
+  T det = T(1);
+  for (int k = 0; k < n_; ++k) {
+    if (pivots[k] >= 0) {
+      det *= at(k, k);
+    } else {
+      det *= at(k, k) * at(k + 1, k + 1) - at(k + 1, k) * at(k + 1, k);
+      ++k;
+    }
+  }
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  if (b.GetRows() != n_) {
+    throw std::invalid_argument("Matrix sizes do not match");
+  }
+  std::pmr::vector<T> ldl(GetResource());
+  std::pmr::vector<int> pivots(GetResource());
+  if (!Factor(ldl, pivots, Tolerance())) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  S21BasicMatrix<T> x(b, GetResource());
+  SolveFactored(ldl, pivots, x);
+  return x;
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T> S21BasicSymmetricMatrix<T>::InverseMatrix() const {
+  std::pmr::vector<T> ldl(GetResource());
+  std::pmr::vector<int> pivots(GetResource());
+  if (!Factor(ldl, pivots, Tolerance())) {
+    throw std::invalid_argument("Matrix determinant must be > 0.");
+  }
+  // Столбцы E решаются полосами по kInverseBlock, из решения берётся
+  // нижний треугольник: памяти n * kInverseBlock сверх результата.
+  S21BasicSymmetricMatrix result(n_, GetResource());
+  S21BasicMatrix<T> x(n_, std::min(n_, kInverseBlock), kS21Uninitialized,
+                      GetResource());
+  for (int j0 = 0; j0 < n_; j0 += kInverseBlock) {
+    const int cols = std::min(kInverseBlock, n_ - j0);
+    x.SetCols(cols);
+    for (int i = 0; i < n_; ++i) {
+      std::fill(x.Row(i), x.Row(i) + cols, T(0));
+    }
+    for (int c = 0; c < cols; ++c) x.Row(j0 + c)[c] = T(1);
+    SolveFactored(ldl, pivots, x);
+    for (int i = j0; i < n_; ++i) {
+      const int end = std::min(cols, i - j0 + 1);
+      std::copy(x.Row(i), x.Row(i) + end, result.Row(i) + j0);
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(n_, n_, kS21Uninitialized, GetResource());
+  for (int i = 0; i < n_; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      result.Row(i)[j] = result.Row(j)[i] = Row(i)[j];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicSymmetricMatrix<T>::Tolerance() const noexcept {
+  T max = T(0);
+  for (T value : data_) max = std::max(max, std::fabs(value));
+  return n_ * std::numeric_limits<T>::epsilon() * max;
+}
+
+// Bunch-Kaufman: на шаге k выбирается блок D 1x1 или 2x2 так, чтобы
+// множители L были ограничены, и строки/столбцы переставляются
+// симметрично только в ещё не разложенной части A[k:n, k:n].
+template <typename T>
+bool S21BasicSymmetricMatrix<T>::Factor(std::pmr::vector<T> &ldl,
+                                        std::pmr::vector<int> &pivots,
+                                        T tolerance) const {
+  ldl.assign(data_.begin(), data_.end());
+  pivots.assign(n_, 0);
+  auto row = [&](int i) {
+    return ldl.data() + static_cast<std::ptrdiff_t>(i) * (i + 1) / 2;
+  };
+  auto at = [&](int i, int j) -> T & {
+    return i >= j ? row(i)[j] : row(j)[i];
+  };
+  // Ведущие столбцы до исключения.
+  std::pmr::vector<T> w1(n_, T(0), GetResource());
+  std::pmr::vector<T> w2(n_, T(0), GetResource());
+  const T alpha = (T(1) + std::sqrt(T(17))) / 8;
+  for (int k = 0; k < n_;) {
+    const T absakk = std::fabs(at(k, k));
+    int imax = k;
+    T colmax = T(0);
+    for (int i = k + 1; i < n_; ++i) {
+      if (std::fabs(at(i, k)) > colmax) {
+        colmax = std::fabs(at(i, k));
+        imax = i;
+      }
+    }
+    if (std::max(absakk, colmax) <= tolerance) return false;
+    int size = 1;
+    int kp = k;
+    if (absakk < alpha * colmax) {
+      T rowmax = T(0);
+      for (int j = k; j < n_; ++j) {
+        if (j != imax) rowmax = std::max(rowmax, std::fabs(at(imax, j)));
+      }
+      if (absakk * rowmax >= alpha * colmax * colmax) {
+        kp = k;
+      } else if (std::fabs(at(imax, imax)) >= alpha * rowmax) {
+        kp = imax;
+      } else {
+        kp = imax;
+        size = 2;
+      }
+    }
+    const int kk = k + size - 1;
+    if (kp != kk) {
+      for (int i = k; i < n_; ++i) {
+        if (i != kk && i != kp) std::swap(at(i, kk), at(i, kp));
+      }
+      std::swap(at(kk, kk), at(kp, kp));
+    }
+    const int next = k + size;
+    for (int i = next; i < n_; ++i) w1[i] = at(i, k);
+    if (size == 1) {
+      pivots[k] = kp;
+      const T d = at(k, k);
+      for (int i = next; i < n_; ++i) {
+        const T l = w1[i] / d;
+        T *row_i = row(i);
+        for (int j = next; j <= i; ++j) row_i[j] -= l * w1[j];
+        row_i[k] = l;
+      }
+    } else {
+      // |det D| >= (1 - alpha^2) * colmax^2, блок не вырожден.
+      pivots[k] = pivots[k + 1] = -(kp + 1);
+      const T d11 = at(k, k);
+      const T d21 = at(k + 1, k);
+      const T d22 = at(k + 1, k + 1);
+      const T det = d11 * d22 - d21 * d21;
+      for (int i = next; i < n_; ++i) w2[i] = at(i, k + 1);
+      for (int i = next; i < n_; ++i) {
+        const T l1 = (w1[i] * d22 - w2[i] * d21) / det;
+        const T l2 = (w2[i] * d11 - w1[i] * d21) / det;
+        T *row_i = row(i);
+        for (int j = next; j <= i; ++j) {
+          row_i[j] -= l1 * w1[j] + l2 * w2[j];
+        }
+        row_i[k] = l1;
+        row_i[k + 1] = l2;
+      }
+    }
+    k = next;
+  }
+  return true;
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::SolveFactored(
+    const std::pmr::vector<T> &ldl, const std::pmr::vector<int> &pivots,
+    S21BasicMatrix<T> &x) const {
+  const int nrhs = x.cols_;
+  auto at = [&](int i, int j) {
+    return ldl[static_cast<std::size_t>(i) * (i + 1) / 2 + j];
+  };
+  auto swap_rows = [&](int i, int j) {
+    if (i != j) std::swap_ranges(x.Row(i), x.Row(i) + nrhs, x.Row(j));
+  };
+  // L * D * Y = P * B: перестановки применяются в порядке разложения.
+  for (int k = 0; k < n_;) {
+    const int size = pivots[k] >= 0 ? 1 : 2;
+    swap_rows(k + size - 1, size == 1 ? pivots[k] : -pivots[k] - 1);
+    T *x_k = x.Row(k);
+    T *x_k1 = size == 2 ? x.Row(k + 1) : nullptr;
+    for (int i = k + size; i < n_; ++i) {
+      T *x_i = x.Row(i);
+      const T l1 = at(i, k);
+      for (int c = 0; c < nrhs; ++c) x_i[c] -= l1 * x_k[c];
+      if (size == 2) {
+        const T l2 = at(i, k + 1);
+        for (int c = 0; c < nrhs; ++c) x_i[c] -= l2 * x_k1[c];
+      }
+    }
+    if (size == 1) {
+      s21_kernels::Scale(x_k, T(1) / at(k, k), nrhs);
+    } else {
+      const T d11 = at(k, k);
+      const T d21 = at(k + 1, k);
+      const T d22 = at(k + 1, k + 1);
+      const T det = d11 * d22 - d21 * d21;
+      for (int c = 0; c < nrhs; ++c) {
+        const T b1 = x_k[c];
+        const T b2 = x_k1[c];
+        x_k[c] = (d22 * b1 - d21 * b2) / det;
+        x_k1[c] = (d11 * b2 - d21 * b1) / det;
+      }
+    }
+    k += size;
+  }
+  // L^T * X = Y, перестановки в обратном порядке.
+  for (int k = n_ - 1; k >= 0;) {
+    const int size = pivots[k] >= 0 ? 1 : 2;
+    for (int r = k; r > k - size; --r) {
+      T *x_r = x.Row(r);
+      for (int i = k + 1; i < n_; ++i) {
+        const T *x_i = x.Row(i);
+        const T l = at(i, r);
+        for (int c = 0; c < nrhs; ++c) x_r[c] -= l * x_i[c];
+      }
+    }
+    swap_rows(k, size == 1 ? pivots[k] : -pivots[k] - 1);
+    k -= size;
+  }
+}
+
+template <typename T>
+T &S21BasicSymmetricMatrix<T>::operator()(int i, int j) {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return i >= j ? Row(i)[j] : Row(j)[i];
+}
+
+template <typename T>
+T S21BasicSymmetricMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= n_ || j < 0 || j >= n_) {
+    throw std::out_of_range("Index is out of the matrix range");
+  }
+  return i >= j ? Row(i)[j] : Row(j)[i];
+}
+
+template class S21BasicBandMatrix<float>;
+template class S21BasicBandMatrix<double>;
+template class S21BasicBandMatrix<long double>;
+template class S21BasicTriangularMatrix<float>;
+template class S21BasicTriangularMatrix<double>;
+template class S21BasicTriangularMatrix<long double>;
+template class S21BasicSymmetricMatrix<float>;
+template class S21BasicSymmetricMatrix<double>;
+template class S21BasicSymmetricMatrix<long double>;
@@ -0,0 +1,251 @@
+#ifndef S21_STRUCTURED_MATRIX_H_
+#define S21_STRUCTURED_MATRIX_H_
+
+// Квадратные матрицы с известной структурой нулей: ленточная,
+// треугольная и симметричная. Хранятся только элементы, которые могут быть
+// ненулевыми, а операции с теми же именами, что у S21BasicMatrix,
+// используют структуру: Determinant() треугольной матрицы - произведение
+// диагонали, решение ленточной системы стоит O(n * ширина ленты^2), а
+// трёхдиагональной - O(n).
+//
+// Шаблоны определены в s21_structured_matrix.cc и инстанцированы для
+// float, double и long double.
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Ленточная матрица n x n: a_ij может быть ненулевым при
+// -lower <= j - i <= upper. Память n * (lower + upper + 1).
+template <typename T>
+class S21BasicBandMatrix {
+ public:
+  using value_type = T;
+
+  S21BasicBandMatrix(int n, int lower, int upper,
+                     std::pmr::memory_resource* resource = nullptr);
+  // Лента плотной квадратной матрицы, элементы вне неё отбрасываются.
+  S21BasicBandMatrix(const S21BasicMatrixView<T>& dense, int lower, int upper,
+                     std::pmr::memory_resource* resource = nullptr);
+  S21BasicBandMatrix(const S21BasicBandMatrix& other);
+  S21BasicBandMatrix(S21BasicBandMatrix&& other) noexcept = default;
+  S21BasicBandMatrix& operator=(const S21BasicBandMatrix& other) = default;
+  S21BasicBandMatrix& operator=(S21BasicBandMatrix&& other) = default;
+
+  // Операции над матрицами:
+  // Лента результата - объединение лент слагаемых.
+  void SumMatrix(const S21BasicBandMatrix& other);
+  void SubMatrix(const S21BasicBandMatrix& other);
+  void MulNumber(T num) noexcept;
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrixView<T>& dense) const;
+  S21BasicBandMatrix Transpose() const;
+  // LU с выбором ведущего элемента внутри ленты: верхняя лента U
+  // расширяется до lower + upper, других заполнений нет.
+  T Determinant() const;
+  // Для вырожденной матрицы бросают то же исключение, что и
+  // S21BasicMatrix::InverseMatrix(). Обратная матрица плотная.
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  S21BasicMatrix<T> InverseMatrix() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Изменить можно только элемент ленты, прочитать через константную
+  // матрицу - любой.
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
+
+  // Доп. функции:
+  int GetRows() const noexcept { return n_; }
+  int GetCols() const noexcept { return n_; }
+  int GetLower() const noexcept { return lower_; }
+  int GetUpper() const noexcept { return upper_; }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return data_.get_allocator().resource();
+  }
+
+ private:
+  int Width() const noexcept { return lower_ + upper_ + 1; }
+  // Row(i)[j] - элемент (i, j) ленты.
+  T* Row(int i) noexcept {
+    return data_.data() + static_cast<std::ptrdiff_t>(i) * Width() + lower_ -
+           i;
+  }
+  const T* Row(int i) const noexcept {
+    return data_.data() + static_cast<std::ptrdiff_t>(i) * Width() + lower_ -
+           i;
+  }
+  void Widen(int lower, int upper);
+  void Merge(const S21BasicBandMatrix& other, T sign);
+  // LU-разложение в lu шириной 2 * lower + upper + 1; perm[k] - строка,
+  // переставленная с k-й на k-м шаге. Возвращает знак перестановки или 0.
+  int Factor(std::pmr::vector<T>& lu, std::pmr::vector<int>& perm,
+             T tolerance) const;
+
+  int n_ = {0};
+  int lower_ = {0};
+  int upper_ = {0};
+  // Строка i занимает Width() элементов, столбцы вне [0, n) - нули.
+  std::pmr::vector<T> data_;
+};
+
+// Какой треугольник хранится.
+enum class S21Triangle { kLower, kUpper };
+
+// Нижняя или верхняя треугольная матрица n x n, упакованная по строкам в
+// n * (n + 1) / 2 элементов.
+template <typename T>
+class S21BasicTriangularMatrix {
+ public:
+  using value_type = T;
+
+  S21BasicTriangularMatrix(int n, S21Triangle triangle,
+                           std::pmr::memory_resource* resource = nullptr);
+  // Треугольник плотной квадратной матрицы.
+  S21BasicTriangularMatrix(const S21BasicMatrixView<T>& dense,
+                           S21Triangle triangle,
+                           std::pmr::memory_resource* resource = nullptr);
+  S21BasicTriangularMatrix(const S21BasicTriangularMatrix& other);
+  S21BasicTriangularMatrix(S21BasicTriangularMatrix&& other) noexcept =
+      default;
+  S21BasicTriangularMatrix& operator=(const S21BasicTriangularMatrix& other) =
+      default;
+  S21BasicTriangularMatrix& operator=(S21BasicTriangularMatrix&& other) =
+      default;
+
+  // Операции над матрицами:
+  // Треугольники слагаемых должны совпадать.
+  void SumMatrix(const S21BasicTriangularMatrix& other);
+  void SubMatrix(const S21BasicTriangularMatrix& other);
+  void MulNumber(T num) noexcept;
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrixView<T>& dense) const;
+  S21BasicTriangularMatrix Transpose() const;
+  // Произведение диагонали.
+  T Determinant() const noexcept;
+  // Прямая или обратная подстановка, O(n^2) на столбец B.
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  // Обратная к треугольной - треугольная того же вида, O(n^3 / 3).
+  S21BasicTriangularMatrix InverseMatrix() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Как у ленточной: вне треугольника только чтение.
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
+
+  // Доп. функции:
+  int GetRows() const noexcept { return n_; }
+  int GetCols() const noexcept { return n_; }
+  S21Triangle GetTriangle() const noexcept { return triangle_; }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return data_.get_allocator().resource();
+  }
+
+ private:
+  bool IsLower() const noexcept { return triangle_ == S21Triangle::kLower; }
+  bool Contains(int i, int j) const noexcept {
+    return IsLower() ? j <= i : j >= i;
+  }
+  // Row(i)[j] - элемент (i, j) треугольника.
+  T* Row(int i) noexcept { return data_.data() + RowOffset(i); }
+  const T* Row(int i) const noexcept { return data_.data() + RowOffset(i); }
+  std::ptrdiff_t RowOffset(int i) const noexcept {
+    const std::ptrdiff_t k = i;
+    return IsLower() ? k * (k + 1) / 2 : k * (2 * n_ - k + 1) / 2 - k;
+  }
+  void CheckSingular() const;
+
+  int n_ = {0};
+  S21Triangle triangle_ = S21Triangle::kLower;
+  std::pmr::vector<T> data_;
+};
+
+// Симметричная матрица n x n: хранится нижний треугольник, упакованный по
+// строкам, a_ij и a_ji - один элемент.
+template <typename T>
+class S21BasicSymmetricMatrix {
+ public:
+  using value_type = T;
+
+  explicit S21BasicSymmetricMatrix(
+      int n, std::pmr::memory_resource* resource = nullptr);
+  // Берётся нижний треугольник плотной квадратной матрицы.
+  explicit S21BasicSymmetricMatrix(
+      const S21BasicMatrixView<T>& dense,
+      std::pmr::memory_resource* resource = nullptr);
+  S21BasicSymmetricMatrix(const S21BasicSymmetricMatrix& other);
+  S21BasicSymmetricMatrix(S21BasicSymmetricMatrix&& other) noexcept = default;
+  S21BasicSymmetricMatrix& operator=(const S21BasicSymmetricMatrix& other) =
+      default;
+  S21BasicSymmetricMatrix& operator=(S21BasicSymmetricMatrix&& other) =
+      default;
+
+  // Операции над матрицами:
+  void SumMatrix(const S21BasicSymmetricMatrix& other);
+  void SubMatrix(const S21BasicSymmetricMatrix& other);
+  void MulNumber(T num) noexcept;
+  // Каждый хранимый элемент читается один раз и работает за a_ij и a_ji.
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrixView<T>& dense) const;
+  S21BasicSymmetricMatrix Transpose() const { return *this; }
+  // LDL^T-разложение с выбором ведущего блока по Банчу-Кауфману прямо в
+  // упакованном виде: n^3 / 3 операций и n * (n + 1) / 2 элементов, работает
+  // и для знаконеопределённых матриц.
+  T Determinant() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T>& b) const;
+  S21BasicSymmetricMatrix InverseMatrix() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
+
+  // Доп. функции:
+  int GetRows() const noexcept { return n_; }
+  int GetCols() const noexcept { return n_; }
+  std::pmr::memory_resource* GetResource() const noexcept {
+    return data_.get_allocator().resource();
+  }
+
+ private:
+  // Row(i)[j] - элемент (i, j) при j <= i.
+  T* Row(int i) noexcept {
+    return data_.data() + static_cast<std::ptrdiff_t>(i) * (i + 1) / 2;
+  }
+  const T* Row(int i) const noexcept {
+    return data_.data() + static_cast<std::ptrdiff_t>(i) * (i + 1) / 2;
+  }
+  // Порог вырожденности n * eps * max|a_ij|.
+  T Tolerance() const noexcept;
+  // P A P^T = L D L^T в ldl с той же упаковкой, что и data_: под
+  // диагональю L (единичная диагональ не хранится), на диагонали и в
+  // элементе (k + 1, k) блока 2x2 - D. pivots[k] - строка, переставленная
+  // с k-й на k-м шаге, или -(p + 1) в обеих строках блока 2x2, вторая
+  // строка которого переставлена с p. false - ведущий столбец не больше
+  // tolerance.
+  bool Factor(std::pmr::vector<T>& ldl, std::pmr::vector<int>& pivots,
+              T tolerance) const;
+  // x = A^-1 * x по готовому разложению.
+  void SolveFactored(const std::pmr::vector<T>& ldl,
+                     const std::pmr::vector<int>& pivots,
+                     S21BasicMatrix<T>& x) const;
+
+  // Столбцов E в одной полосе InverseMatrix().
+  static constexpr int kInverseBlock = 64;
+
+  int n_ = {0};
+  std::pmr::vector<T> data_;
+};
+
+using S21BandMatrix = S21BasicBandMatrix<double>;
+using S21TriangularMatrix = S21BasicTriangularMatrix<double>;
+using S21SymmetricMatrix = S21BasicSymmetricMatrix<double>;
+
+extern template class S21BasicBandMatrix<float>;
+extern template class S21BasicBandMatrix<double>;
+extern template class S21BasicBandMatrix<long double>;
+extern template class S21BasicTriangularMatrix<float>;
+extern template class S21BasicTriangularMatrix<double>;
+extern template class S21BasicTriangularMatrix<long double>;
+extern template class S21BasicSymmetricMatrix<float>;
+extern template class S21BasicSymmetricMatrix<double>;
+extern template class S21BasicSymmetricMatrix<long double>;
+
+#endif  // S21_STRUCTURED_MATRIX_H_
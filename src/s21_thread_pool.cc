@@ -0,0 +1,117 @@
+#include "s21_thread_pool.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+// Поток пула или поток, уже выполняющий ParallelFor.
+thread_local bool in_parallel_region = false;
+
+int DefaultThreadCount() {
+  int count = static_cast<int>(std::thread::hardware_concurrency());
+  const char* env = std::getenv("S21_MATRIX_THREADS");
+  if (env != nullptr && std::atoi(env) > 0) {
+    count = std::atoi(env);
+  }
+  return count > 0 ? count : 1;
+}
+
+}  // namespace
+
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+S21ThreadPool::S21ThreadPool() { Start(DefaultThreadCount()); }
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+int S21ThreadPool::GetThreadCount() const noexcept {
+  return thread_count_.load(std::memory_order_relaxed);
+}
+
+void S21ThreadPool::SetThreadCount(int count) {
+  if (count < 1) {
+    throw std::invalid_argument("Thread count cannot be less than 1");
+  }
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  Stop();
+  Start(count);
+}
+
+void S21ThreadPool::ParallelFor(int count,
+                                const std::function<void(int)>& task) {
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::defer_lock);
+  // workers_ читается только под run_mutex_: SetThreadCount() меняет его
+  // под той же блокировкой.
+  if (count <= 1 || in_parallel_region || !run_lock.try_lock() ||
+      workers_.empty()) {
+    for (int i = 0; i < count; ++i) task(i);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_.store(0);
+    error_ = nullptr;
+    active_ = static_cast<int>(workers_.size());
+    ++generation_;
+  }
+  start_.notify_all();
+  in_parallel_region = true;
+  RunTasks();
+  in_parallel_region = false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return active_ == 0; });
+  task_ = nullptr;
+  if (error_) std::rethrow_exception(error_);
+}
+
+void S21ThreadPool::Start(int count) {
+  stop_ = false;
+  for (int i = 1; i < count; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, generation_);
+  }
+  thread_count_.store(count, std::memory_order_relaxed);
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear();
+  thread_count_.store(1, std::memory_order_relaxed);
+}
+
+void S21ThreadPool::WorkerLoop(unsigned long generation) {
+  in_parallel_region = true;
+  unsigned long seen = generation;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+    if (stop_) break;
+    seen = generation_;
+    lock.unlock();
+    RunTasks();
+    lock.lock();
+    if (--active_ == 0) done_.notify_one();
+  }
+}
+
+void S21ThreadPool::RunTasks() {
+  for (int i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+      next_.store(count_);
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Постоянный пул потоков библиотеки. Потоки создаются один раз, а
+// ParallelFor раздаёт им индексы задач, поэтому параллельная операция не
+// платит за создание потоков.
+//
+// Число потоков по умолчанию равно std::thread::hardware_concurrency() и
+// может быть задано переменной окружения S21_MATRIX_THREADS или
+// SetThreadCount().
+class S21ThreadPool {
+ public:
+  static S21ThreadPool& Instance();
+
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  // Число потоков вместе с вызывающим (не меньше 1).
+  int GetThreadCount() const noexcept;
+  void SetThreadCount(int count);
+
+  // Выполняет task(0) ... task(count - 1) и ждёт завершения всех задач.
+  // Вызывающий поток тоже берёт задачи. Вложенный вызов из задачи или
+  // одновременный вызов из другого потока выполняется последовательно.
+  // Первое исключение из задач пробрасывается вызывающему.
+  void ParallelFor(int count, const std::function<void(int)>& task);
+
+ private:
+  S21ThreadPool();
+  void Start(int count);
+  void Stop();
+  void WorkerLoop(unsigned long generation);
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+  // Копия workers_.size() + 1 для чтения без блокировки во время
+  // SetThreadCount() из другого потока.
+  std::atomic<int> thread_count_{1};
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  const std::function<void(int)>* task_ = nullptr;
+  int count_ = 0;
+  std::atomic<int> next_{0};
+  std::exception_ptr error_;
+  int active_ = 0;
+  unsigned long generation_ = 0;
+  bool stop_ = false;
+};
+
+#endif  // S21_THREAD_POOL_H_